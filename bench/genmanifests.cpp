@@ -0,0 +1,268 @@
+/*
+ * Copyright (C) 2026 Microchip Technology Inc.  All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+/*
+ * Generate a synthetic tree of launcher manifests, to benchmark loading.
+ */
+
+#include <algorithm>
+#include <cairo.h>
+#include <cmath>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <getopt.h>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+namespace
+{
+
+enum class ManifestLayout
+{
+    feed,
+    entry,
+    mixed,
+};
+
+struct GenOptions
+{
+    /// Number of manifest files.
+    unsigned files{10};
+    /// Entries per manifest file.
+    unsigned entries{10};
+    /// Manifest files per directory.
+    unsigned per_dir{100};
+    /// Entries per <screen> in the feed layout.
+    unsigned per_screen{12};
+    ManifestLayout layout{ManifestLayout::mixed};
+    /// Number of distinct icons, 0 for entries without an icon.
+    unsigned icons{16};
+    /// Width and height of the icons.
+    int icon_size{128};
+    std::string dir;
+};
+
+void usage(const char* name)
+{
+    std::cout << "Usage: " << name << " [OPTION]... DIR\n"
+              << "Generate a tree of launcher manifests in DIR.\n\n"
+              << "  -f, --files=N         number of manifest files (default: 10)\n"
+              << "  -e, --entries=N       entries per manifest file (default: 10)\n"
+              << "  -d, --per-dir=N       manifest files per directory (default: 100)\n"
+              << "  -l, --layout=LAYOUT   feed for <feed>/<screen>/<entry>, entry for bare\n"
+              << "                        <entry> elements, or mixed to alternate\n"
+              << "                        (default: mixed)\n"
+              << "  -i, --icons=N         number of distinct PNG icons, 0 for none\n"
+              << "                        (default: 16)\n"
+              << "  -s, --icon-size=N     width and height of the icons (default: 128)\n"
+              << "  -h, --help            show this help and exit\n";
+}
+
+GenOptions parse_options(int argc, char** argv)
+{
+    GenOptions options;
+
+    static const struct option long_options[] =
+    {
+        {"files", required_argument, nullptr, 'f'},
+        {"entries", required_argument, nullptr, 'e'},
+        {"per-dir", required_argument, nullptr, 'd'},
+        {"layout", required_argument, nullptr, 'l'},
+        {"icons", required_argument, nullptr, 'i'},
+        {"icon-size", required_argument, nullptr, 's'},
+        {"help", no_argument, nullptr, 'h'},
+        {nullptr, 0, nullptr, 0},
+    };
+
+    int c;
+    // NOLINTNEXTLINE(concurrency-mt-unsafe)
+    while ((c = getopt_long(argc, argv, "f:e:d:l:i:s:h", long_options, nullptr)) != -1)
+    {
+        switch (c)
+        {
+        case 'f':
+            options.files = std::strtoul(optarg, nullptr, 10);
+            break;
+        case 'e':
+            options.entries = std::strtoul(optarg, nullptr, 10);
+            break;
+        case 'd':
+            options.per_dir = std::max<unsigned>(std::strtoul(optarg, nullptr, 10), 1);
+            break;
+        case 'l':
+            if (std::string(optarg) == "feed")
+                options.layout = ManifestLayout::feed;
+            else if (std::string(optarg) == "entry")
+                options.layout = ManifestLayout::entry;
+            else if (std::string(optarg) == "mixed")
+                options.layout = ManifestLayout::mixed;
+            else
+            {
+                std::cerr << "unknown layout " << optarg << std::endl;
+                std::exit(EXIT_FAILURE);
+            }
+            break;
+        case 'i':
+            options.icons = std::strtoul(optarg, nullptr, 10);
+            break;
+        case 's':
+            options.icon_size = std::max(std::atoi(optarg), 1);
+            break;
+        case 'h':
+            usage(argv[0]);
+            std::exit(EXIT_SUCCESS);
+        default:
+            usage(argv[0]);
+            std::exit(EXIT_FAILURE);
+        }
+    }
+
+    if (optind != argc - 1)
+    {
+        usage(argv[0]);
+        std::exit(EXIT_FAILURE);
+    }
+
+    options.dir = argv[optind];
+    return options;
+}
+
+std::string numbered(const std::string& prefix, unsigned index, const std::string& suffix)
+{
+    std::ostringstream ss;
+    ss << prefix << std::setw(5) << std::setfill('0') << index << suffix;
+    return ss.str();
+}
+
+/*
+ * Draw an icon with some gradients, so it does not compress to nothing.
+ */
+bool write_icon(const std::string& path, unsigned index, int size)
+{
+    auto* surface = cairo_image_surface_create(CAIRO_FORMAT_ARGB32, size, size);
+    auto* cr = cairo_create(surface);
+
+    const double hue = (index * 0.618033988749895) - std::floor(index * 0.618033988749895);
+    auto* pattern = cairo_pattern_create_radial(size * 0.3, size * 0.3, 0,
+                    size * 0.5, size * 0.5, size * 0.7);
+    cairo_pattern_add_color_stop_rgb(pattern, 0, 1, 1, 1);
+    cairo_pattern_add_color_stop_rgb(pattern, 1, hue, 1 - hue, 0.5);
+
+    cairo_arc(cr, size / 2., size / 2., size * 0.45, 0, 2 * M_PI);
+    cairo_set_source(cr, pattern);
+    cairo_fill(cr);
+    cairo_pattern_destroy(pattern);
+    cairo_destroy(cr);
+
+    const auto status = cairo_surface_write_to_png(surface, path.c_str());
+    cairo_surface_destroy(surface);
+    return status == CAIRO_STATUS_SUCCESS;
+}
+
+void write_entry(std::ostream& out, const GenOptions& options, const std::string& icons,
+                 unsigned file, unsigned entry, const char* indent)
+{
+    const auto index = file * options.entries + entry;
+
+    out << indent << "<entry>\n"
+        << indent << "  <title>App " << index << "</title>\n"
+        << indent << "  <description>Synthetic entry " << entry << " of manifest " << file
+        << "</description>\n";
+    if (options.icons)
+    {
+        out << indent << "  <link rel=\"enclosure\" type=\"image/png\" href=\""
+            << numbered(icons + "/icon-", index % options.icons, ".png") << "\" />\n";
+    }
+    out << indent << "  <arg>/bin/true " << index << "</arg>\n"
+        << indent << "</entry>\n";
+}
+
+bool write_manifest(const std::string& path, const GenOptions& options,
+                    const std::string& icons, unsigned file)
+{
+    std::ofstream out(path, std::ios::trunc);
+    if (!out.is_open())
+        return false;
+
+    auto layout = options.layout;
+    if (layout == ManifestLayout::mixed)
+        layout = (file % 2) ? ManifestLayout::entry : ManifestLayout::feed;
+
+    out << "<?xml version=\"1.0\" encoding=\"utf-8\"?>\n";
+
+    if (layout == ManifestLayout::feed)
+    {
+        out << "<feed>\n";
+        for (unsigned entry = 0; entry < options.entries; ++entry)
+        {
+            if (entry % options.per_screen == 0)
+                out << "  <screen>\n";
+            write_entry(out, options, icons, file, entry, "    ");
+            if (entry % options.per_screen == options.per_screen - 1 || entry == options.entries - 1)
+                out << "  </screen>\n";
+        }
+        out << "</feed>\n";
+    }
+    else
+    {
+        for (unsigned entry = 0; entry < options.entries; ++entry)
+            write_entry(out, options, icons, file, entry, "");
+    }
+
+    return out.good();
+}
+
+}
+
+int main(int argc, char** argv)
+{
+    const auto options = parse_options(argc, argv);
+
+    std::error_code ec;
+    const auto root = std::filesystem::absolute(options.dir, ec).string();
+    const auto icons = root + "/icons";
+    std::filesystem::create_directories(icons, ec);
+    if (ec)
+    {
+        std::cerr << "cannot create " << icons << ": " << ec.message() << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    // the icons live outside of the scanned manifests, but are referenced
+    // with absolute paths
+    for (unsigned i = 0; i < options.icons; ++i)
+    {
+        const auto path = numbered(icons + "/icon-", i, ".png");
+        if (!write_icon(path, i, options.icon_size))
+        {
+            std::cerr << "cannot write " << path << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+
+    for (unsigned file = 0; file < options.files; ++file)
+    {
+        const auto dir = numbered(root + "/manifests/d", file / options.per_dir, "");
+        std::filesystem::create_directories(dir, ec);
+        const auto path = numbered(dir + "/app-", file, ".xml");
+        if (ec || !write_manifest(path, options, icons, file))
+        {
+            std::cerr << "cannot write " << path << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+
+    std::cout << options.files << " manifests with " << options.files * options.entries <<
+              " entries in " << root << "/manifests" << std::endl;
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,55 @@
+#!/bin/sh
+
+#
+# Measure how loading the launcher scales with the number of entries.
+#
+# usage: run-benchmark.sh LAUNCHER GENERATOR [ENTRIES]...
+#
+# For each number of entries (default: 10 100 1000 10000), a manifest tree is
+# generated and loaded twice by the launcher on an offscreen screen: once with
+# an empty cache, and once with the cache written by the first run.
+#
+# The generated trees can be tuned with these environment variables:
+#   ENTRIES_PER_FILE  entries per manifest file (default: 10)
+#   LAYOUT            feed, entry or mixed (default: mixed)
+#   ICON_SIZE         width and height of the icons (default: 128)
+#   JOBS              threads used by the launcher to scan and parse (default: 1)
+#
+
+if [ $# -lt 2 ]
+then
+    echo "usage: $0 LAUNCHER GENERATOR [ENTRIES]..." >&2
+    exit 1
+fi
+
+launcher=$1
+generator=$2
+shift 2
+sizes=${*:-10 100 1000 10000}
+
+per_file=${ENTRIES_PER_FILE:-10}
+layout=${LAYOUT:-mixed}
+icon_size=${ICON_SIZE:-128}
+jobs=${JOBS:-1}
+
+work=$(mktemp -d) || exit 1
+trap 'rm -rf "$work"' EXIT
+
+# no display needed
+export EGT_BACKEND=memory
+
+for entries in $sizes
+do
+    files=$(( (entries + per_file - 1) / per_file ))
+    rm -rf "$work/tree" "$work/cache"
+
+    "$generator" --files=$files --entries=$per_file --layout=$layout \
+        --icon-size=$icon_size "$work/tree" > /dev/null || exit 1
+
+    for run in cold warm
+    do
+        printf "%s " $run
+        "$launcher" --benchmark --jobs=$jobs --cache-dir="$work/cache" \
+            "$work/tree/manifests" || exit 1
+    done
+done
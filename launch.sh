@@ -6,31 +6,56 @@
 
 handle_exit_key()
 {
-    # try to read KEY_0 from keyboard0 to exit the application
-    device='/dev/input/keyboard0'
-    if [ -c "$device" ]
+    # let a launcher timing the launch know the application is started, it
+    # may then write "ready" on the same fd once its first frame is shown
+    if [ -n "$EGT_LAUNCHER_READY_FD" ]
     then
-	(
-	    key_0='*type 1 (EV_KEY), code 11 (KEY_0), value 1*'
-	    evtest "$device" | while read line; do
-		case $line in
-		    ($key_0)
-			killall -9 $1
-			exit 0
-			;;
-		esac
-	    done
-	) &
+	echo exec >&"$EGT_LAUNCHER_READY_FD"
     fi
 
-    $@
+    $@ &
+    app=$!
+
+    # end the application on KEY_0 from keyboard0, or on the keys of its
+    # entry passed in $EGT_LAUNCHER_EXIT_KEYS, with SIGTERM then SIGKILL
+    watcher=
+    if [ -c /dev/input/keyboard0 ] && command -v egt-launcher-exitkey > /dev/null
+    then
+	egt-launcher-exitkey $app &
+	watcher=$!
+    fi
+
+    wait $app
+    status=$?
+
+    # an application ended with an exit key has not failed, so a resident
+    # launcher does not restart it
+    if [ -n "$watcher" ] && wait $watcher
+    then
+	status=0
+    fi
+    return $status
 }
 
 run()
 {
+    # the arguments the launcher was started with, quoted, not for the
+    # application
+    args=$EGT_LAUNCHER_ARGS
+    unset EGT_LAUNCHER_ARGS
+
     handle_exit_key $@
-    egt-launcher
+    eval "set -- $args"
+    egt-launcher "$@"
 }
 
+# a resident launcher waits for the application itself and is not relaunched
+if [ "$1" = "--resident" ]
+then
+    shift
+    handle_exit_key $@
+    exit $?
+fi
+
 # redirect stdout, stderr to /dev/null, close stdin and double fork - it's magic
 ((run $@ > /dev/null 2>&1 <&- &)&)
@@ -0,0 +1,224 @@
+/*
+ * Copyright (C) 2026 Microchip Technology Inc.  All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "allocstats.h"
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+
+namespace
+{
+
+/**
+ * Counters of a path.
+ *
+ * Everything here is constant initialized, as operator new may be called
+ * before any constructor runs.
+ */
+struct PathStats
+{
+    std::atomic<const char*> path;
+    std::atomic<uint64_t> calls;
+    std::atomic<uint64_t> allocs;
+    std::atomic<uint64_t> bytes;
+    std::atomic<uint64_t> frees;
+};
+
+/// Distinct paths accounted, the first slot is for "other".
+const size_t MAX_PATHS = 32;
+
+std::array<PathStats, MAX_PATHS> paths;
+std::atomic<bool> accounting{false};
+thread_local PathStats* current = nullptr;
+
+PathStats& charged()
+{
+    return current ? *current : paths[0];
+}
+
+PathStats* find_path(const char* path)
+{
+    for (size_t i = 1; i < MAX_PATHS; ++i)
+    {
+        const char* expected = nullptr;
+        if (paths[i].path.compare_exchange_strong(expected, path) || expected == path)
+            return &paths[i];
+    }
+
+    return &paths[0];
+}
+
+void allocated(std::size_t size)
+{
+    if (!accounting.load(std::memory_order_relaxed))
+        return;
+
+    auto& stats = charged();
+    stats.allocs.fetch_add(1, std::memory_order_relaxed);
+    stats.bytes.fetch_add(size, std::memory_order_relaxed);
+}
+
+void freed(void* ptr)
+{
+    if (!ptr || !accounting.load(std::memory_order_relaxed))
+        return;
+
+    charged().frees.fetch_add(1, std::memory_order_relaxed);
+}
+
+void* allocate(std::size_t size)
+{
+    allocated(size);
+
+    if (size == 0)
+        size = 1;
+
+    while (true)
+    {
+        // NOLINTNEXTLINE(cppcoreguidelines-no-malloc)
+        if (void* ptr = std::malloc(size))
+            return ptr;
+
+        auto handler = std::get_new_handler();
+        if (!handler)
+            throw std::bad_alloc();
+        handler();
+    }
+}
+
+void* allocate(std::size_t size, const std::nothrow_t&) noexcept
+{
+    try
+    {
+        return allocate(size);
+    }
+    catch (...)
+    {
+        return nullptr;
+    }
+}
+
+void deallocate(void* ptr) noexcept
+{
+    freed(ptr);
+    // NOLINTNEXTLINE(cppcoreguidelines-no-malloc)
+    std::free(ptr);
+}
+
+}
+
+AllocStats::Scope::Scope(const char* path)
+{
+    if (!enabled())
+        return;
+
+    auto* stats = find_path(path);
+    stats->calls.fetch_add(1, std::memory_order_relaxed);
+
+    m_active = true;
+    m_previous = current;
+    current = stats;
+}
+
+AllocStats::Scope::~Scope()
+{
+    if (m_active)
+        current = static_cast<PathStats*>(m_previous);
+}
+
+void AllocStats::enable()
+{
+    paths[0].path = "other";
+    accounting = true;
+}
+
+bool AllocStats::enabled()
+{
+    return accounting.load(std::memory_order_relaxed);
+}
+
+void AllocStats::report(std::ostream& out)
+{
+    for (auto& stats : paths)
+    {
+        const char* path = stats.path;
+        if (!path)
+            continue;
+
+        // the report allocates, so read the counters of the line first
+        const auto calls = stats.calls.exchange(0);
+        const auto allocs = stats.allocs.exchange(0);
+        const auto bytes = stats.bytes.exchange(0);
+        const auto frees = stats.frees.exchange(0);
+        if (!allocs && !frees && !calls)
+            continue;
+
+        out << "alloc path=" << path << " calls=" << calls << " allocs=" << allocs
+            << " bytes=" << bytes << " frees=" << frees;
+        if (calls)
+        {
+            out << " allocs_per_call=" << static_cast<double>(allocs) / calls
+                << " bytes_per_call=" << static_cast<double>(bytes) / calls;
+        }
+        out << "\n";
+    }
+    out.flush();
+}
+
+void* operator new(std::size_t size)
+{
+    return allocate(size);
+}
+
+void* operator new[](std::size_t size)
+{
+    return allocate(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t& tag) noexcept
+{
+    return allocate(size, tag);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t& tag) noexcept
+{
+    return allocate(size, tag);
+}
+
+void operator delete(void* ptr) noexcept
+{
+    deallocate(ptr);
+}
+
+void operator delete[](void* ptr) noexcept
+{
+    deallocate(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept
+{
+    deallocate(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t) noexcept
+{
+    deallocate(ptr);
+}
+
+void operator delete(void* ptr, const std::nothrow_t&) noexcept
+{
+    deallocate(ptr);
+}
+
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept
+{
+    deallocate(ptr);
+}
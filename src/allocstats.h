@@ -0,0 +1,86 @@
+/*
+ * Copyright (C) 2026 Microchip Technology Inc.  All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#ifndef EGT_LAUNCHER_ALLOCSTATS_H
+#define EGT_LAUNCHER_ALLOCSTATS_H
+
+#include <cstddef>
+#include <ostream>
+
+/**
+ * Accounting of the heap allocations, by code path.
+ *
+ * The global operator new and delete are replaced to count the calls and
+ * the bytes requested, which are charged to the innermost Scope of the
+ * calling thread, or to "other" outside of any. This includes the
+ * allocations EGT makes on behalf of the launcher.
+ *
+ * While disabled, an allocation costs one atomic load, and so does a Scope.
+ *
+ * Only built with ENABLE_ALLOC_STATS, otherwise operator new and delete are
+ * left alone and a Scope compiles to nothing.
+ */
+#ifdef ENABLE_ALLOC_STATS
+class AllocStats
+{
+public:
+
+    /**
+     * Charge the allocations of the calling thread to path for the lifetime
+     * of the object.
+     */
+    class Scope
+    {
+    public:
+
+        /**
+         * path must be a string literal.
+         */
+        explicit Scope(const char* path);
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+        ~Scope();
+
+    private:
+        bool m_active{false};
+        void* m_previous{nullptr};
+    };
+
+    static void enable();
+
+    static bool enabled();
+
+    /**
+     * Write the allocations of each path since the last report, with their
+     * average per call of the path, and reset the counters.
+     */
+    static void report(std::ostream& out);
+};
+#else
+class AllocStats
+{
+public:
+
+    class Scope
+    {
+    public:
+
+        explicit Scope(const char*) {}
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+    };
+
+    static void enable() {}
+
+    static bool enabled() { return false; }
+
+    static void report(std::ostream&) {}
+};
+#endif
+
+#endif
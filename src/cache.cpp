@@ -0,0 +1,195 @@
+/*
+ * Copyright (C) 2026 Microchip Technology Inc.  All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "cache.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <fcntl.h>
+#include <iostream>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+bool file_stamp(const std::string& path, FileStamp& stamp)
+{
+    struct stat st {};
+    if (::stat(path.c_str(), &st) < 0)
+        return false;
+
+    stamp.mtime = static_cast<int64_t>(st.st_mtim.tv_sec) * 1000000000LL + st.st_mtim.tv_nsec;
+    stamp.size = st.st_size;
+    return true;
+}
+
+std::string default_cache_dir()
+{
+    // NOLINTNEXTLINE(concurrency-mt-unsafe)
+    const char* dir = std::getenv("EGT_LAUNCHER_CACHE_DIR");
+    if (dir)
+        return dir;
+
+    return "/var/cache/egt-launcher";
+}
+
+std::string cache_file(const std::string& dir, const std::string& name)
+{
+    if (dir.empty())
+        return {};
+
+    std::error_code ec;
+    std::filesystem::create_directories(dir, ec);
+    if (ec)
+    {
+        std::cerr << "cannot create cache directory " << dir << ": " << ec.message() << std::endl;
+        return {};
+    }
+
+    return dir + "/" + name;
+}
+
+bool write_file_atomic(const std::string& path, const std::string& data)
+{
+    return write_file_atomic(path, [&data](std::ostream & out)
+    {
+        out.write(data.data(), static_cast<std::streamsize>(data.size()));
+        return true;
+    });
+}
+
+bool write_file_atomic(const std::string& path, const std::function<bool(std::ostream&)>& write)
+{
+    const auto tmp = path + ".tmp." + std::to_string(::getpid());
+
+    {
+        std::ofstream out(tmp, std::ios::binary | std::ios::trunc);
+        if (!out.is_open())
+            return false;
+        if (!write(out) || !out.flush().good())
+        {
+            out.close();
+            std::remove(tmp.c_str());
+            return false;
+        }
+    }
+
+    if (std::rename(tmp.c_str(), path.c_str()) < 0)
+    {
+        std::remove(tmp.c_str());
+        return false;
+    }
+
+    return true;
+}
+
+bool read_file(const std::string& path, std::string& data)
+{
+    std::ifstream in(path, std::ios::binary);
+    if (!in.is_open())
+        return false;
+
+    in.seekg(0, std::ios::end);
+    const auto size = in.tellg();
+    if (size < 0)
+        return false;
+    in.seekg(0);
+
+    data.resize(static_cast<size_t>(size));
+    in.read(&data[0], size);
+    return in.good();
+}
+
+std::shared_ptr<MappedFile> MappedFile::open(const std::string& path)
+{
+    if (path.empty())
+        return nullptr;
+
+    const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+        return nullptr;
+
+    struct stat st {};
+    if (::fstat(fd, &st) < 0 || st.st_size <= 0)
+    {
+        ::close(fd);
+        return nullptr;
+    }
+
+    const auto size = static_cast<size_t>(st.st_size);
+    void* addr = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (addr == MAP_FAILED)
+        return nullptr;
+
+    return std::make_shared<MappedFile>(addr, size);
+}
+
+MappedFile::~MappedFile()
+{
+    ::munmap(m_addr, m_size);
+}
+
+void CacheWriter::u32(uint32_t value)
+{
+    m_data.append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+void CacheWriter::u64(uint64_t value)
+{
+    m_data.append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+void CacheWriter::str(const std::string& value)
+{
+    u32(value.size());
+    m_data.append(value);
+}
+
+bool CacheReader::take(void* out, size_t len)
+{
+    if (!m_ok || len > m_size - m_pos)
+    {
+        m_ok = false;
+        return false;
+    }
+
+    std::memcpy(out, m_data + m_pos, len);
+    m_pos += len;
+    return true;
+}
+
+uint32_t CacheReader::u32()
+{
+    uint32_t value = 0;
+    take(&value, sizeof(value));
+    return value;
+}
+
+uint64_t CacheReader::u64()
+{
+    uint64_t value = 0;
+    take(&value, sizeof(value));
+    return value;
+}
+
+std::string CacheReader::str()
+{
+    const auto len = u32();
+    if (!m_ok || len > m_size - m_pos)
+    {
+        m_ok = false;
+        return {};
+    }
+
+    std::string value(m_data + m_pos, len);
+    m_pos += len;
+    return value;
+}
@@ -0,0 +1,160 @@
+/*
+ * Copyright (C) 2026 Microchip Technology Inc.  All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#ifndef EGT_LAUNCHER_CACHE_H
+#define EGT_LAUNCHER_CACHE_H
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <ostream>
+#include <string>
+
+/**
+ * Identity of a file on disk, used to decide if cached data is still valid.
+ */
+struct FileStamp
+{
+    /// Modification time in nanoseconds.
+    int64_t mtime{0};
+    /// Size in bytes.
+    uint64_t size{0};
+
+    bool operator==(const FileStamp& rhs) const
+    {
+        return mtime == rhs.mtime && size == rhs.size;
+    }
+
+    bool operator!=(const FileStamp& rhs) const
+    {
+        return !(*this == rhs);
+    }
+};
+
+/**
+ * Get the stamp of a file, returns false if the file cannot be stat'ed.
+ */
+bool file_stamp(const std::string& path, FileStamp& stamp);
+
+/**
+ * Default directory used for the on-disk caches.
+ *
+ * This is EGT_LAUNCHER_CACHE_DIR if set in the environment.
+ */
+std::string default_cache_dir();
+
+/**
+ * Build the path of a cache file, creating the cache directory if needed.
+ *
+ * Returns an empty string if caching is disabled or the directory cannot be
+ * created.
+ */
+std::string cache_file(const std::string& dir, const std::string& name);
+
+/**
+ * Replace the contents of a file atomically.
+ *
+ * The data is written to a temporary file which is then renamed, so a reader
+ * never sees a partially written cache.
+ */
+bool write_file_atomic(const std::string& path, const std::string& data);
+
+/**
+ * Replace the contents of a file atomically, with what write puts in the
+ * stream, without holding the whole file in memory.
+ *
+ * The file is left unchanged if write returns false.
+ */
+bool write_file_atomic(const std::string& path, const std::function<bool(std::ostream&)>& write);
+
+/**
+ * Read a whole file into memory.
+ */
+bool read_file(const std::string& path, std::string& data);
+
+/**
+ * Private, copy on write, memory mapping of a whole cache file.
+ *
+ * The mapping is writable so its pixels can be handed to cairo, but changes
+ * never reach the file.
+ */
+class MappedFile
+{
+public:
+
+    /**
+     * Map a file, returns nullptr if missing or empty.
+     */
+    static std::shared_ptr<MappedFile> open(const std::string& path);
+
+    MappedFile(void* addr, size_t size)
+        : m_addr(addr),
+          m_size(size)
+    {}
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    ~MappedFile();
+
+    unsigned char* data() const { return static_cast<unsigned char*>(m_addr); }
+    size_t size() const { return m_size; }
+
+private:
+    void* m_addr;
+    size_t m_size;
+};
+
+/**
+ * Append primitive values to a binary cache buffer.
+ */
+class CacheWriter
+{
+public:
+
+    void u32(uint32_t value);
+    void u64(uint64_t value);
+    void str(const std::string& value);
+
+    const std::string& data() const { return m_data; }
+
+private:
+    std::string m_data;
+};
+
+/**
+ * Read primitive values back from a binary cache buffer.
+ *
+ * Any out of bounds read puts the reader in a failed state, and every
+ * following read returns a default value.
+ */
+class CacheReader
+{
+public:
+
+    CacheReader(const char* data, size_t size)
+        : m_data(data),
+          m_size(size)
+    {}
+
+    uint32_t u32();
+    uint64_t u64();
+    std::string str();
+
+    bool ok() const { return m_ok; }
+    bool done() const { return m_pos == m_size; }
+    size_t pos() const { return m_pos; }
+
+private:
+
+    bool take(void* out, size_t len);
+
+    const char* m_data;
+    size_t m_size;
+    size_t m_pos{0};
+    bool m_ok{true};
+};
+
+#endif
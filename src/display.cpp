@@ -0,0 +1,160 @@
+/*
+ * Copyright (C) 2026 Microchip Technology Inc.  All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "display.h"
+#include <cstring>
+#include <dirent.h>
+#include <iostream>
+#include <string>
+#include <unistd.h>
+
+#ifdef HAVE_LIBDRM
+#include <xf86drm.h>
+#include <xf86drmMode.h>
+#endif
+
+struct DisplayHandoff::Crtc
+{
+    int fd;
+    uint32_t crtc_id;
+    uint32_t fb_id;
+    uint32_t x;
+    uint32_t y;
+#ifdef HAVE_LIBDRM
+    drmModeModeInfo mode;
+#endif
+    std::vector<uint32_t> connectors;
+};
+
+/**
+ * DRM device file descriptors opened by this process.
+ */
+static std::vector<int> drm_fds()
+{
+    std::vector<int> fds;
+
+    DIR* dir = opendir("/proc/self/fd");
+    if (!dir)
+        return fds;
+
+    while (auto* entry = readdir(dir))
+    {
+        if (entry->d_name[0] == '.')
+            continue;
+
+        const auto path = std::string("/proc/self/fd/") + entry->d_name;
+        char target[256] = {};
+        if (readlink(path.c_str(), target, sizeof(target) - 1) < 0)
+            continue;
+
+        if (std::strncmp(target, "/dev/dri/card", 13) == 0)
+            fds.push_back(std::stoi(entry->d_name));
+    }
+
+    closedir(dir);
+    return fds;
+}
+
+DisplayHandoff::DisplayHandoff() = default;
+
+DisplayHandoff::~DisplayHandoff() = default;
+
+bool DisplayHandoff::release()
+{
+#ifdef HAVE_LIBDRM
+    m_fds = drm_fds();
+    m_crtcs.clear();
+
+    for (auto fd : m_fds)
+    {
+        auto* res = drmModeGetResources(fd);
+        if (!res)
+            continue;
+
+        for (int c = 0; c < res->count_crtcs; ++c)
+        {
+            auto* crtc = drmModeGetCrtc(fd, res->crtcs[c]);
+            if (!crtc)
+                continue;
+
+            if (crtc->buffer_id && crtc->mode_valid)
+            {
+                Crtc saved{fd, crtc->crtc_id, crtc->buffer_id, crtc->x, crtc->y, crtc->mode, {}};
+
+                for (int n = 0; n < res->count_connectors; ++n)
+                {
+                    auto* connector = drmModeGetConnector(fd, res->connectors[n]);
+                    if (!connector)
+                        continue;
+
+                    if (connector->encoder_id)
+                    {
+                        auto* encoder = drmModeGetEncoder(fd, connector->encoder_id);
+                        if (encoder && encoder->crtc_id == crtc->crtc_id)
+                            saved.connectors.push_back(connector->connector_id);
+                        drmModeFreeEncoder(encoder);
+                    }
+
+                    drmModeFreeConnector(connector);
+                }
+
+                m_crtcs.push_back(std::move(saved));
+            }
+
+            drmModeFreeCrtc(crtc);
+        }
+
+        drmModeFreeResources(res);
+    }
+
+    bool ok = true;
+    for (auto fd : m_fds)
+    {
+        if (drmDropMaster(fd) < 0)
+        {
+            std::cerr << "cannot drop DRM master: " << std::strerror(errno) << std::endl;
+            ok = false;
+        }
+    }
+
+    return ok;
+#else
+    return true;
+#endif
+}
+
+bool DisplayHandoff::acquire()
+{
+#ifdef HAVE_LIBDRM
+    bool ok = true;
+    for (auto fd : m_fds)
+    {
+        if (drmSetMaster(fd) < 0)
+        {
+            std::cerr << "cannot become DRM master: " << std::strerror(errno) << std::endl;
+            ok = false;
+        }
+    }
+
+    for (auto& crtc : m_crtcs)
+    {
+        if (drmModeSetCrtc(crtc.fd, crtc.crtc_id, crtc.fb_id, crtc.x, crtc.y,
+                           crtc.connectors.data(), crtc.connectors.size(), &crtc.mode) < 0)
+        {
+            std::cerr << "cannot restore CRTC " << crtc.crtc_id << ": " <<
+                      std::strerror(errno) << std::endl;
+            ok = false;
+        }
+    }
+
+    return ok;
+#else
+    return true;
+#endif
+}
@@ -0,0 +1,44 @@
+/*
+ * Copyright (C) 2026 Microchip Technology Inc.  All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#ifndef EGT_LAUNCHER_DISPLAY_H
+#define EGT_LAUNCHER_DISPLAY_H
+
+#include <cstdint>
+#include <vector>
+
+/**
+ * Hand the KMS/DRM device over to another process and take it back.
+ *
+ * release() drops DRM master on every DRM device the launcher has open, so
+ * a child can become master and modeset. Once the child exits, acquire()
+ * becomes master again and restores the CRTC configuration saved by
+ * release(), as the kernel turns the CRTCs off when the child's
+ * framebuffers go away.
+ *
+ * Without libdrm both are no-ops, which is fine for the non KMS backends.
+ */
+class DisplayHandoff
+{
+public:
+
+    DisplayHandoff();
+    DisplayHandoff(const DisplayHandoff&) = delete;
+    DisplayHandoff& operator=(const DisplayHandoff&) = delete;
+    ~DisplayHandoff();
+
+    bool release();
+
+    bool acquire();
+
+private:
+
+    struct Crtc;
+
+    std::vector<int> m_fds;
+    std::vector<Crtc> m_crtcs;
+};
+
+#endif
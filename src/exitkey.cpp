@@ -0,0 +1,73 @@
+/*
+ * Copyright (C) 2026 Microchip Technology Inc.  All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "exitkey.h"
+#include <fcntl.h>
+#include <iostream>
+#include <unistd.h>
+
+ExitKey::ExitKey(asio::io_context& io)
+    : m_device(io)
+{}
+
+ExitKey::~ExitKey()
+{
+    stop();
+}
+
+bool ExitKey::start(const KeyCodes& keys, PressedCallback callback)
+{
+    stop();
+
+    const int fd = ::open(EXIT_KEY_DEVICE, O_RDONLY | O_NONBLOCK | O_CLOEXEC);
+    if (fd < 0)
+        return false;
+
+    m_device.assign(fd);
+    m_keys = keys;
+    m_callback = std::move(callback);
+    read();
+    return true;
+}
+
+void ExitKey::stop()
+{
+    asio::error_code ec;
+    m_device.close(ec);
+    m_callback = nullptr;
+}
+
+void ExitKey::read()
+{
+    m_device.async_read_some(asio::buffer(m_events),
+                             [this](const asio::error_code & ec, std::size_t length)
+    {
+        if (ec)
+        {
+            if (ec != asio::error::operation_aborted)
+                std::cerr << EXIT_KEY_DEVICE << ": " << ec.message() << std::endl;
+            return;
+        }
+
+        // evdev only returns whole events
+        for (size_t i = 0; i < length / sizeof(struct input_event); ++i)
+        {
+            const auto& event = m_events[i];
+            if (m_callback && is_exit_key(event, m_keys))
+            {
+                auto callback = m_callback;
+                callback();
+                if (!m_device.is_open())
+                    return;
+            }
+        }
+
+        read();
+    });
+}
@@ -0,0 +1,51 @@
+/*
+ * Copyright (C) 2026 Microchip Technology Inc.  All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#ifndef EGT_LAUNCHER_EXITKEY_H
+#define EGT_LAUNCHER_EXITKEY_H
+
+#include "keywatch.h"
+#include <array>
+#include <egt/asio.hpp>
+#include <functional>
+
+/**
+ * Watch the keyboard for the keys which end the running application.
+ *
+ * This is watch_exit_keys() for an application the launcher waits for
+ * itself: the device is read from the io_context, only while the
+ * application runs.
+ */
+class ExitKey
+{
+public:
+
+    using PressedCallback = std::function<void()>;
+
+    explicit ExitKey(asio::io_context& io);
+
+    ExitKey(const ExitKey&) = delete;
+    ExitKey& operator=(const ExitKey&) = delete;
+
+    ~ExitKey();
+
+    /**
+     * Start watching for keys, returns false if there is no keyboard.
+     */
+    bool start(const KeyCodes& keys, PressedCallback callback);
+
+    void stop();
+
+private:
+
+    void read();
+
+    asio::posix::stream_descriptor m_device;
+    KeyCodes m_keys;
+    PressedCallback m_callback;
+    std::array<struct input_event, 16> m_events{};
+};
+
+#endif
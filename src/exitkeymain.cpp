@@ -0,0 +1,88 @@
+/*
+ * Copyright (C) 2026 Microchip Technology Inc.  All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "keywatch.h"
+#include <cstdlib>
+#include <getopt.h>
+#include <iostream>
+
+/*
+ * Helper of launch.sh, ending the application it started on an exit key.
+ */
+
+static void usage(const char* name)
+{
+    std::cout << "Usage: " << name << " [OPTION]... PID\n"
+              << "End the process PID when an exit key is pressed on " << EXIT_KEY_DEVICE << ",\n"
+              << "with SIGTERM, then SIGKILL if it does not exit in time. Returns once PID\n"
+              << "has exited, with status 0 only if it was ended with a key.\n\n"
+              << "  -k, --keys=CODES      key codes ending the process, separated by commas\n"
+              << "                        (default: $" << EXIT_KEYS_ENV << ", or KEY_0)\n"
+              << "  -g, --grace=MS        time given to exit on SIGTERM (default: "
+              << EXIT_GRACE.count() << ")\n"
+              << "  -h, --help            show this help and exit\n";
+}
+
+int main(int argc, char** argv)
+{
+    KeyCodes keys;
+    auto grace = EXIT_GRACE;
+
+    // NOLINTNEXTLINE(concurrency-mt-unsafe)
+    if (const char* list = std::getenv(EXIT_KEYS_ENV))
+        parse_key_codes(list, keys);
+
+    static const struct option long_options[] =
+    {
+        {"keys", required_argument, nullptr, 'k'},
+        {"grace", required_argument, nullptr, 'g'},
+        {"help", no_argument, nullptr, 'h'},
+        {nullptr, 0, nullptr, 0},
+    };
+
+    int c;
+    // NOLINTNEXTLINE(concurrency-mt-unsafe)
+    while ((c = getopt_long(argc, argv, "k:g:h", long_options, nullptr)) != -1)
+    {
+        switch (c)
+        {
+        case 'k':
+            if (!parse_key_codes(optarg, keys))
+            {
+                std::cerr << "invalid key codes: " << optarg << std::endl;
+                return EXIT_FAILURE;
+            }
+            break;
+        case 'g':
+            grace = std::chrono::milliseconds(std::strtoul(optarg, nullptr, 10));
+            break;
+        case 'h':
+            usage(argv[0]);
+            return EXIT_SUCCESS;
+        default:
+            usage(argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    if (optind + 1 != argc)
+    {
+        usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    const auto pid = static_cast<pid_t>(std::strtol(argv[optind], nullptr, 10));
+    if (pid <= 0)
+    {
+        std::cerr << "invalid pid: " << argv[optind] << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    return watch_exit_keys(pid, keys, grace) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
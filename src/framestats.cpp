@@ -0,0 +1,98 @@
+/*
+ * Copyright (C) 2026 Microchip Technology Inc.  All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "framestats.h"
+
+static uint64_t to_us(FrameStats::Clock::duration d)
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(d).count();
+}
+
+const char* frame_activity_name(FrameActivity activity)
+{
+    switch (activity)
+    {
+    case FrameActivity::page_turn:
+        return "page_turn";
+    case FrameActivity::drag:
+        return "drag";
+    case FrameActivity::marquee:
+        return "marquee";
+    default:
+        return "none";
+    }
+}
+
+FrameStats::FrameStats(std::chrono::microseconds period)
+    : m_period(period)
+{}
+
+bool FrameStats::rendered(FrameActivity activity, Clock::time_point start, Clock::time_point end)
+{
+    const bool first = !m_drawing;
+    if (first)
+    {
+        if (activity == FrameActivity::none)
+        {
+            m_last_activity = activity;
+            return false;
+        }
+
+        m_drawing = true;
+        m_activity = activity;
+        m_start = start;
+        m_render = {};
+    }
+
+    m_render += end - start;
+    m_render_end = end;
+    return first;
+}
+
+void FrameStats::flipped(Clock::time_point now)
+{
+    if (!m_drawing)
+        return;
+    m_drawing = false;
+
+    auto& s = stats(m_activity);
+    s.render.record(to_us(m_render));
+    s.flip.record(to_us(now - m_render_end));
+
+    if (m_last_activity == m_activity)
+    {
+        const auto gap = m_start - m_last_start;
+        if (gap <= MAX_GAP)
+        {
+            const auto frames = (gap + m_period / 2) / m_period;
+            if (frames > 1)
+                s.dropped += frames - 1;
+        }
+    }
+
+    m_last_activity = m_activity;
+    m_last_start = m_start;
+}
+
+void FrameStats::report(std::ostream& out) const
+{
+    for (auto activity : {FrameActivity::page_turn, FrameActivity::drag, FrameActivity::marquee})
+    {
+        auto& s = stats(activity);
+        out << frame_activity_name(activity) << " frames=" << s.render.count() << " dropped=" << s.dropped;
+        for (auto& [histogram, kind] : {std::make_pair(&s.render, "render"), std::make_pair(&s.flip, "flip")})
+        {
+            out << " " << kind << "_p50_us=" << histogram->percentile(0.50)
+                << " " << kind << "_p95_us=" << histogram->percentile(0.95)
+                << " " << kind << "_p99_us=" << histogram->percentile(0.99);
+        }
+        out << "\n";
+    }
+    out.flush();
+}
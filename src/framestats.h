@@ -0,0 +1,113 @@
+/*
+ * Copyright (C) 2026 Microchip Technology Inc.  All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#ifndef EGT_LAUNCHER_FRAMESTATS_H
+#define EGT_LAUNCHER_FRAMESTATS_H
+
+#include "histogram.h"
+#include <array>
+#include <chrono>
+#include <ostream>
+
+/**
+ * What the launcher is animating while a frame is drawn.
+ */
+enum class FrameActivity
+{
+    /// Nothing, the frame is not accounted.
+    none,
+    /// Pager scrolling to a page, after a swipe or a drag.
+    page_turn,
+    /// Pager following the pointer.
+    drag,
+    /// Taglines scrolling.
+    marquee,
+};
+
+/**
+ * Name of an activity, as used in reports.
+ */
+const char* frame_activity_name(FrameActivity activity);
+
+/**
+ * Render and flip times of the frames drawn while something is animated.
+ *
+ * A window may be drawn several times per frame, once per damaged
+ * rectangle, so the render time is the sum of these draws. The flip time
+ * goes from the end of the last draw until the event loop is done with the
+ * frame.
+ *
+ * Frames are counted as dropped when the gap between two frames of the same
+ * activity is longer than the frame period. Gaps longer than MAX_GAP start a
+ * new run of the activity instead, like the pauses of the taglines or a
+ * pointer held still while dragging.
+ */
+class FrameStats
+{
+public:
+
+    using Clock = std::chrono::steady_clock;
+
+    static constexpr std::chrono::milliseconds MAX_GAP{250};
+
+    explicit FrameStats(std::chrono::microseconds period = std::chrono::microseconds(16667));
+
+    /**
+     * Account a draw of the window.
+     *
+     * Returns true for the first draw of a frame, flipped() must then be
+     * called once the frame is on screen.
+     */
+    bool rendered(FrameActivity activity, Clock::time_point start, Clock::time_point end);
+
+    /**
+     * End the current frame.
+     */
+    void flipped(Clock::time_point now);
+
+    /**
+     * Write percentiles and dropped frames, one line per activity.
+     */
+    void report(std::ostream& out) const;
+
+    const Histogram& render(FrameActivity activity) const { return stats(activity).render; }
+    const Histogram& flip(FrameActivity activity) const { return stats(activity).flip; }
+    uint64_t dropped(FrameActivity activity) const { return stats(activity).dropped; }
+
+private:
+
+    struct Stats
+    {
+        Histogram render;
+        Histogram flip;
+        uint64_t dropped{0};
+    };
+
+    Stats& stats(FrameActivity activity)
+    {
+        return m_stats[static_cast<size_t>(activity) - 1];
+    }
+
+    const Stats& stats(FrameActivity activity) const
+    {
+        return m_stats[static_cast<size_t>(activity) - 1];
+    }
+
+    std::chrono::microseconds m_period;
+    std::array<Stats, 3> m_stats;
+
+    /// Frame being drawn.
+    bool m_drawing{false};
+    FrameActivity m_activity{FrameActivity::none};
+    Clock::time_point m_start;
+    Clock::time_point m_render_end;
+    Clock::duration m_render{};
+
+    /// Previous frame, to find dropped frames.
+    FrameActivity m_last_activity{FrameActivity::none};
+    Clock::time_point m_last_start;
+};
+
+#endif
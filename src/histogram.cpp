@@ -0,0 +1,83 @@
+/*
+ * Copyright (C) 2026 Microchip Technology Inc.  All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "histogram.h"
+#include <algorithm>
+#include <cmath>
+
+size_t Histogram::index(uint64_t value)
+{
+    if (value < LINEAR)
+        return value;
+
+    // keep the 6 most significant bits, the first one is always set
+    const auto shift = (63 - __builtin_clzll(value)) - 5;
+    const auto sub = (value >> shift) - SUB_BUCKETS;
+    return LINEAR + (shift - 1) * SUB_BUCKETS + sub;
+}
+
+uint64_t Histogram::highest(size_t index)
+{
+    if (index < LINEAR)
+        return index;
+
+    const auto shift = (index - LINEAR) / SUB_BUCKETS + 1;
+    const auto sub = (index - LINEAR) % SUB_BUCKETS + SUB_BUCKETS;
+    return ((sub + 1) << shift) - 1;
+}
+
+void Histogram::record(uint64_t value)
+{
+    value = std::min<uint64_t>(value, UINT32_MAX);
+    m_buckets[index(value)]++;
+
+    if (!m_count || value < m_min)
+        m_min = value;
+    m_max = std::max(m_max, value);
+    m_sum += value;
+    m_count++;
+}
+
+uint64_t Histogram::percentile(double q) const
+{
+    if (!m_count)
+        return 0;
+
+    const auto rank = std::max<uint64_t>(std::ceil(std::clamp(q, 0., 1.) * m_count), 1);
+
+    uint64_t seen = 0;
+    for (size_t i = 0; i < BUCKETS; ++i)
+    {
+        seen += m_buckets[i];
+        if (seen >= rank)
+            return std::clamp(highest(i), m_min, m_max);
+    }
+
+    return m_max;
+}
+
+uint64_t Histogram::count_at_most(uint64_t value) const
+{
+    if (value >= m_max)
+        return m_count;
+
+    uint64_t count = 0;
+    for (size_t i = 0; i < BUCKETS && highest(i) <= value; ++i)
+        count += m_buckets[i];
+    return count;
+}
+
+void Histogram::reset()
+{
+    m_buckets.fill(0);
+    m_count = 0;
+    m_min = 0;
+    m_max = 0;
+    m_sum = 0;
+}
@@ -0,0 +1,63 @@
+/*
+ * Copyright (C) 2026 Microchip Technology Inc.  All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#ifndef EGT_LAUNCHER_HISTOGRAM_H
+#define EGT_LAUNCHER_HISTOGRAM_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * Histogram of values with a bounded relative error, in the spirit of
+ * HdrHistogram.
+ *
+ * Values below 64 have a bucket each. Above, every power of two range is
+ * split in 32 buckets, so a value is known within about 3%. Values up to
+ * 2^32 - 1 are kept, larger ones are clamped. Recording is O(1) and the
+ * memory used is fixed.
+ */
+class Histogram
+{
+public:
+
+    void record(uint64_t value);
+
+    /**
+     * Value at or below which a fraction q, in [0, 1], of the values are.
+     *
+     * Returns 0 if the histogram is empty.
+     */
+    uint64_t percentile(double q) const;
+
+    /**
+     * Number of values at or below value, within the error of the buckets.
+     */
+    uint64_t count_at_most(uint64_t value) const;
+
+    uint64_t count() const { return m_count; }
+    uint64_t min() const { return m_count ? m_min : 0; }
+    uint64_t max() const { return m_max; }
+    uint64_t sum() const { return m_sum; }
+
+    void reset();
+
+private:
+
+    static constexpr size_t LINEAR = 64;
+    static constexpr size_t SUB_BUCKETS = 32;
+    static constexpr size_t BUCKETS = LINEAR + 26 * SUB_BUCKETS;
+
+    static size_t index(uint64_t value);
+    static uint64_t highest(size_t index);
+
+    std::array<uint64_t, BUCKETS> m_buckets{};
+    uint64_t m_count{0};
+    uint64_t m_min{0};
+    uint64_t m_max{0};
+    uint64_t m_sum{0};
+};
+
+#endif
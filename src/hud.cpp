@@ -0,0 +1,132 @@
+/*
+ * Copyright (C) 2026 Microchip Technology Inc.  All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "hud.h"
+#include "iconcache.h"
+#include "iconloader.h"
+#include "process.h"
+#include <cairo.h>
+#include <cstdio>
+#include <sys/resource.h>
+
+static const double FONT_SIZE = 14.;
+static const double LINE_HEIGHT = 17.;
+
+static std::chrono::microseconds cpu_time()
+{
+    struct rusage usage {};
+    ::getrusage(RUSAGE_SELF, &usage);
+    return std::chrono::seconds(usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) +
+           std::chrono::microseconds(usage.ru_utime.tv_usec + usage.ru_stime.tv_usec);
+}
+
+static double to_ms(PerfHud::Clock::duration d)
+{
+    return std::chrono::duration<double, std::milli>(d).count();
+}
+
+static double to_mib(uint64_t bytes)
+{
+    return bytes / (1024. * 1024.);
+}
+
+PerfHud::PerfHud(const egt::Rect& rect, IconCache& cache)
+    : egt::Widget(rect),
+      m_cache(cache)
+{
+    m_timer.on_timeout([this]() { update(); });
+    hide();
+}
+
+void PerfHud::toggle()
+{
+    if (visible())
+    {
+        m_timer.stop();
+        hide();
+        return;
+    }
+
+    m_frames = 0;
+    m_worst = {};
+    m_update = Clock::now();
+    m_cpu = cpu_time();
+    update();
+    show();
+    m_timer.start();
+}
+
+void PerfHud::frame(Clock::time_point start, Clock::time_point end)
+{
+    m_last = end - start;
+    m_worst = std::max(m_worst, m_last);
+    ++m_frames;
+}
+
+bool PerfHud::covers(const egt::Rect& rect) const
+{
+    return visible() && box().contains(rect);
+}
+
+void PerfHud::update()
+{
+    const auto now = Clock::now();
+    const auto cpu = cpu_time();
+    const auto elapsed = std::chrono::duration<double>(now - m_update).count();
+
+    double fps = 0;
+    double load = 0;
+    if (elapsed > 0)
+    {
+        fps = m_frames / elapsed;
+        load = 100. * std::chrono::duration<double>(cpu - m_cpu).count() / elapsed;
+    }
+
+    std::array<char, 64> line{};
+    std::snprintf(line.data(), line.size(), "fps %.1f", fps);
+    m_lines[0] = line.data();
+    std::snprintf(line.data(), line.size(), "frame %.1f ms, worst %.1f ms",
+                  to_ms(m_last), to_ms(m_worst));
+    m_lines[1] = line.data();
+    std::snprintf(line.data(), line.size(), "cpu %.0f%%", load);
+    m_lines[2] = line.data();
+    std::snprintf(line.data(), line.size(), "rss %.1f MiB", to_mib(resident_memory()));
+    m_lines[3] = line.data();
+    std::snprintf(line.data(), line.size(), "surfaces %.1f MiB, mapped %.1f MiB",
+                  to_mib(icon_surface_bytes()), to_mib(m_cache.mapped_bytes()));
+    m_lines[4] = line.data();
+
+    m_frames = 0;
+    m_worst = {};
+    m_update = now;
+    m_cpu = cpu;
+
+    damage();
+}
+
+void PerfHud::draw(egt::Painter& painter, const egt::Rect&)
+{
+    auto* cr = painter.context().get();
+    const auto b = box();
+
+    cairo_save(cr);
+    cairo_set_source_rgba(cr, 0, 0, 0, 0.7);
+    cairo_rectangle(cr, b.x(), b.y(), b.width(), b.height());
+    cairo_fill(cr);
+
+    cairo_select_font_face(cr, "monospace", CAIRO_FONT_SLANT_NORMAL, CAIRO_FONT_WEIGHT_NORMAL);
+    cairo_set_font_size(cr, FONT_SIZE);
+    cairo_set_source_rgb(cr, 1, 1, 1);
+    for (size_t i = 0; i < m_lines.size(); ++i)
+    {
+        cairo_move_to(cr, b.x() + 6, b.y() + (i + 1) * LINE_HEIGHT);
+        cairo_show_text(cr, m_lines[i].c_str());
+    }
+    cairo_restore(cr);
+}
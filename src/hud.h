@@ -0,0 +1,67 @@
+/*
+ * Copyright (C) 2026 Microchip Technology Inc.  All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#ifndef EGT_LAUNCHER_HUD_H
+#define EGT_LAUNCHER_HUD_H
+
+#include <array>
+#include <chrono>
+#include <egt/ui>
+#include <string>
+
+class IconCache;
+
+/**
+ * Overlay showing the frame rate, frame times, CPU and memory use of the
+ * launcher.
+ *
+ * The text is refreshed once per second, which only damages the box of the
+ * overlay. Frames which only repaint the overlay are not accounted, so it
+ * does not show its own cost.
+ */
+class PerfHud : public egt::Widget
+{
+public:
+
+    using Clock = std::chrono::steady_clock;
+
+    PerfHud(const egt::Rect& rect, IconCache& cache);
+
+    /**
+     * Show or hide the overlay, it is only refreshed while visible.
+     */
+    void toggle();
+
+    /**
+     * A frame, whose drawing started at start, is on screen.
+     */
+    void frame(Clock::time_point start, Clock::time_point end);
+
+    /**
+     * Tell if a damaged rectangle is entirely covered by the overlay.
+     */
+    bool covers(const egt::Rect& rect) const;
+
+    void draw(egt::Painter& painter, const egt::Rect& rect) override;
+
+private:
+
+    void update();
+
+    IconCache& m_cache;
+    egt::PeriodicTimer m_timer{std::chrono::seconds(1)};
+    std::array<std::string, 5> m_lines;
+
+    /// Frames since the last update.
+    size_t m_frames{0};
+    Clock::duration m_last{};
+    Clock::duration m_worst{};
+
+    /// Time and CPU time of the last update.
+    Clock::time_point m_update;
+    std::chrono::microseconds m_cpu{0};
+};
+
+#endif
@@ -0,0 +1,221 @@
+/*
+ * Copyright (C) 2026 Microchip Technology Inc.  All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "iconcache.h"
+#include <iostream>
+
+/// Identifies the icon cache file, bump the version on any format change.
+static const uint32_t ICON_CACHE_MAGIC = 0x49474745; // "EGGI"
+static const uint32_t ICON_CACHE_VERSION = 1;
+/// Alignment of the pixel data of each icon in the file.
+static const size_t ICON_CACHE_ALIGN = 64;
+
+static size_t align_up(size_t value)
+{
+    return (value + ICON_CACHE_ALIGN - 1) & ~(ICON_CACHE_ALIGN - 1);
+}
+
+IconCache::IconCache(std::string path, int width, int height)
+    : m_path(std::move(path)),
+      m_width(width),
+      m_height(height),
+      m_stride(cairo_format_stride_for_width(CAIRO_FORMAT_ARGB32, width))
+{}
+
+bool IconCache::open()
+{
+    if (m_path.empty())
+        return false;
+
+    auto mapping = MappedFile::open(m_path);
+    if (!mapping)
+        return false;
+
+    const auto size = mapping->size();
+    CacheReader in(reinterpret_cast<const char*>(mapping->data()), size);
+    if (in.u32() != ICON_CACHE_MAGIC || in.u32() != ICON_CACHE_VERSION)
+        return false;
+
+    // a different item size invalidates everything
+    if (in.u32() != static_cast<uint32_t>(CAIRO_FORMAT_ARGB32) ||
+        in.u32() != static_cast<uint32_t>(m_width) ||
+        in.u32() != static_cast<uint32_t>(m_height) ||
+        in.u32() != static_cast<uint32_t>(m_stride))
+        return false;
+
+    const auto icon_size = static_cast<size_t>(m_stride) * m_height;
+
+    std::unordered_map<std::string, Entry> entries;
+    const auto count = in.u32();
+    for (uint32_t i = 0; i < count && in.ok(); ++i)
+    {
+        auto path = in.str();
+        Entry entry;
+        entry.stamp.mtime = static_cast<int64_t>(in.u64());
+        entry.stamp.size = in.u64();
+        entry.offset = in.u64();
+        if (entry.offset % ICON_CACHE_ALIGN || entry.offset > size || icon_size > size - entry.offset)
+        {
+            std::cerr << "ignoring corrupted icon cache " << m_path << std::endl;
+            return false;
+        }
+        entries.emplace(std::move(path), std::move(entry));
+    }
+
+    if (!in.ok())
+        return false;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_mapping = std::move(mapping);
+    m_entries = std::move(entries);
+    return true;
+}
+
+IconSurface IconCache::map_surface(size_t offset)
+{
+    auto* data = m_mapping->data() + offset;
+    auto* surface = cairo_image_surface_create_for_data(data, CAIRO_FORMAT_ARGB32,
+                    m_width, m_height, m_stride);
+
+    // the mapping must outlive every surface pointing into it
+    auto mapping = m_mapping;
+    return IconSurface(surface, [mapping](cairo_surface_t * s)
+    {
+        cairo_surface_destroy(s);
+    });
+}
+
+size_t IconCache::mapped_bytes()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_mapping ? m_mapping->size() : 0;
+}
+
+bool IconCache::maps(cairo_surface_t* surface)
+{
+    const auto* data = cairo_image_surface_get_data(surface);
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_mapping && data >= m_mapping->data() && data < m_mapping->data() + m_mapping->size();
+}
+
+IconSurface IconCache::lookup(const std::string& path)
+{
+    FileStamp stamp;
+    const bool valid = file_stamp(path, stamp);
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    auto i = m_entries.find(path);
+    if (!valid || i == m_entries.end() || i->second.stamp != stamp)
+    {
+        ++m_misses;
+        return nullptr;
+    }
+
+    ++m_hits;
+    m_used.insert(path);
+
+    auto& entry = i->second;
+    if (!entry.surface)
+        entry.surface = map_surface(entry.offset);
+
+    return entry.surface;
+}
+
+void IconCache::store(const std::string& path, const FileStamp& stamp, const IconSurface& surface)
+{
+    if (m_path.empty() || !surface ||
+        cairo_image_surface_get_format(surface.get()) != CAIRO_FORMAT_ARGB32 ||
+        cairo_image_surface_get_width(surface.get()) != m_width ||
+        cairo_image_surface_get_height(surface.get()) != m_height)
+        return;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    auto& entry = m_entries[path];
+    entry.stamp = stamp;
+    entry.offset = 0;
+    entry.surface = surface;
+    m_used.insert(path);
+    m_dirty = true;
+}
+
+bool IconCache::save()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    if (m_path.empty() || !m_dirty)
+        return true;
+
+    const auto icon_size = static_cast<size_t>(m_stride) * m_height;
+
+    CacheWriter index;
+    index.u32(ICON_CACHE_MAGIC);
+    index.u32(ICON_CACHE_VERSION);
+    index.u32(static_cast<uint32_t>(CAIRO_FORMAT_ARGB32));
+    index.u32(m_width);
+    index.u32(m_height);
+    index.u32(m_stride);
+    index.u32(m_used.size());
+
+    // the index size is known up front, so the pixel offsets can be computed
+    size_t index_size = index.data().size();
+    for (auto& path : m_used)
+        index_size += sizeof(uint32_t) + path.size() + 3 * sizeof(uint64_t);
+
+    auto offset = align_up(index_size);
+    for (auto& path : m_used)
+    {
+        auto& entry = m_entries[path];
+        index.str(path);
+        index.u64(static_cast<uint64_t>(entry.stamp.mtime));
+        index.u64(entry.stamp.size);
+        index.u64(offset);
+        offset += align_up(icon_size);
+    }
+
+    // the pixels are streamed to the file, not copied to the heap first
+    const auto write = [this, &index](std::ostream & out)
+    {
+        static const std::string padding(ICON_CACHE_ALIGN, '\0');
+
+        out.write(index.data().data(), static_cast<std::streamsize>(index.data().size()));
+        size_t size = index.data().size();
+        for (auto& path : m_used)
+        {
+            auto& entry = m_entries[path];
+            if (!entry.surface)
+                entry.surface = map_surface(entry.offset);
+
+            cairo_surface_flush(entry.surface.get());
+            const auto* pixels = cairo_image_surface_get_data(entry.surface.get());
+            const auto stride = cairo_image_surface_get_stride(entry.surface.get());
+
+            out.write(padding.data(), static_cast<std::streamsize>(align_up(size) - size));
+            size = align_up(size);
+            for (int y = 0; y < m_height; ++y)
+            {
+                out.write(reinterpret_cast<const char*>(pixels) + static_cast<size_t>(y) * stride,
+                          m_stride);
+                size += m_stride;
+            }
+        }
+        return out.good();
+    };
+
+    if (!write_file_atomic(m_path, write))
+    {
+        std::cerr << "cannot write icon cache " << m_path << std::endl;
+        return false;
+    }
+
+    m_dirty = false;
+    return true;
+}
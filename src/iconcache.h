@@ -0,0 +1,98 @@
+/*
+ * Copyright (C) 2026 Microchip Technology Inc.  All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#ifndef EGT_LAUNCHER_ICONCACHE_H
+#define EGT_LAUNCHER_ICONCACHE_H
+
+#include "cache.h"
+#include "iconloader.h"
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+
+/**
+ * Persistent cache of icons already decoded and scaled to the item size.
+ *
+ * Pixels are stored in CAIRO_FORMAT_ARGB32, the format EGT composes in, and
+ * the file is memory mapped so that a hit costs no decoding and no copy.
+ * Icons are keyed by source path and stamp. The target size is stored once
+ * in the header, so the whole cache is dropped when the screen resolution or
+ * the layout changes the item size.
+ */
+class IconCache
+{
+public:
+
+    /**
+     * @param path Cache file, empty to disable the cache.
+     */
+    IconCache(std::string path, int width, int height);
+
+    /**
+     * Map the cache file, returns false if missing or invalid.
+     */
+    bool open();
+
+    /**
+     * Get a cached icon, or nullptr if the source file changed or is unknown.
+     */
+    IconSurface lookup(const std::string& path);
+
+    /**
+     * Add a decoded icon, it must have the size of the cache.
+     */
+    void store(const std::string& path, const FileStamp& stamp, const IconSurface& surface);
+
+    /**
+     * Rewrite the cache file if icons were added since it was opened.
+     *
+     * Only icons looked up or stored since open() are kept.
+     */
+    bool save();
+
+    /**
+     * Size of the mapping of the cache file.
+     */
+    size_t mapped_bytes();
+
+    /**
+     * Tell if the pixels of a surface are in the mapping of the cache file.
+     */
+    bool maps(cairo_surface_t* surface);
+
+    size_t hits() const { return m_hits; }
+    size_t misses() const { return m_misses; }
+
+private:
+
+    struct Entry
+    {
+        FileStamp stamp;
+        /// Offset of the pixels in the mapping, if read from the cache file.
+        size_t offset{0};
+        /// Mapped or decoded pixels, created on demand for mapped icons.
+        IconSurface surface;
+    };
+
+    IconSurface map_surface(size_t offset);
+
+    std::string m_path;
+    int m_width;
+    int m_height;
+    int m_stride;
+    std::shared_ptr<MappedFile> m_mapping;
+    std::mutex m_mutex;
+    std::unordered_map<std::string, Entry> m_entries;
+    std::unordered_set<std::string> m_used;
+    bool m_dirty{false};
+    /// Counted by the loader thread, read from the UI thread.
+    std::atomic<size_t> m_hits{0};
+    std::atomic<size_t> m_misses{0};
+};
+
+#endif
@@ -0,0 +1,176 @@
+/*
+ * Copyright (C) 2026 Microchip Technology Inc.  All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "iconcache.h"
+#include "iconloader.h"
+#include "trace.h"
+#include <atomic>
+#include <egt/asio.hpp>
+
+static std::atomic<size_t> surface_bytes{0};
+
+IconSurface make_icon_surface(cairo_surface_t* surface)
+{
+    const auto bytes = static_cast<size_t>(cairo_image_surface_get_stride(surface)) *
+                       cairo_image_surface_get_height(surface);
+    surface_bytes += bytes;
+
+    return IconSurface(surface, [bytes](cairo_surface_t * s)
+    {
+        surface_bytes -= bytes;
+        cairo_surface_destroy(s);
+    });
+}
+
+size_t icon_surface_bytes()
+{
+    return surface_bytes;
+}
+
+IconSurface decode_icon(const std::string& path, int width, int height)
+{
+    Tracer::Scope trace("decode_icon", "icons", path);
+
+    auto src = make_icon_surface(cairo_image_surface_create_from_png(path.c_str()));
+    if (cairo_surface_status(src.get()) != CAIRO_STATUS_SUCCESS)
+        return nullptr;
+
+    const auto src_width = cairo_image_surface_get_width(src.get());
+    const auto src_height = cairo_image_surface_get_height(src.get());
+    if (src_width <= 0 || src_height <= 0)
+        return nullptr;
+
+    if (src_width == width && src_height == height &&
+        cairo_image_surface_get_format(src.get()) == CAIRO_FORMAT_ARGB32)
+        return src;
+
+    auto dst = make_icon_surface(cairo_image_surface_create(CAIRO_FORMAT_ARGB32, width, height));
+    if (cairo_surface_status(dst.get()) != CAIRO_STATUS_SUCCESS)
+        return nullptr;
+
+    auto cr = cairo_create(dst.get());
+    cairo_scale(cr,
+                static_cast<double>(width) / src_width,
+                static_cast<double>(height) / src_height);
+    cairo_set_source_surface(cr, src.get(), 0, 0);
+    cairo_pattern_set_filter(cairo_get_source(cr), CAIRO_FILTER_GOOD);
+    cairo_set_operator(cr, CAIRO_OPERATOR_SOURCE);
+    cairo_paint(cr);
+    cairo_destroy(cr);
+    cairo_surface_flush(dst.get());
+
+    return dst;
+}
+
+IconLoader::IconLoader(asio::io_context& io, IconCache* cache)
+    : m_io(io),
+      m_cache(cache)
+{}
+
+IconLoader::~IconLoader()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_cond.notify_one();
+
+    if (m_thread.joinable())
+        m_thread.join();
+}
+
+void IconLoader::request(size_t page, const std::string& path, int width, int height,
+                         Callback callback)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_pending[page].push_back({path, width, height, std::move(callback)});
+
+        // the worker is only created once there is something to decode
+        if (!m_thread.joinable())
+            m_thread = std::thread(&IconLoader::run, this);
+    }
+    m_cond.notify_one();
+}
+
+void IconLoader::focus(size_t page)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_focus = page;
+}
+
+bool IconLoader::next(Request& request)
+{
+    if (m_pending.empty())
+        return false;
+
+    // closest page to the focus, preferring the one after on a tie
+    auto i = m_pending.lower_bound(m_focus);
+    if (i == m_pending.end() ||
+        (i != m_pending.begin() && i->first != m_focus &&
+         m_focus - std::prev(i)->first < i->first - m_focus))
+        i = std::prev(i);
+
+    request = std::move(i->second.front());
+    i->second.pop_front();
+    if (i->second.empty())
+        m_pending.erase(i);
+
+    return true;
+}
+
+void IconLoader::run()
+{
+    Tracer::instance().thread_name("icon loader");
+
+    const auto ready = [this]() { return m_stop || !m_pending.empty(); };
+    // the whole cache file is rewritten, once the requests settled
+    bool unsaved = false;
+
+    while (true)
+    {
+        Request request;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            if (!unsaved)
+            {
+                m_cond.wait(lock, ready);
+            }
+            else if (!m_cond.wait_for(lock, SAVE_DELAY, ready))
+            {
+                lock.unlock();
+                m_cache->save();
+                unsaved = false;
+                continue;
+            }
+
+            if (m_stop)
+                break;
+            next(request);
+        }
+
+        FileStamp stamp;
+        const bool stamped = file_stamp(request.path, stamp);
+
+        auto surface = decode_icon(request.path, request.width, request.height);
+        if (m_cache && surface && stamped)
+        {
+            m_cache->store(request.path, stamp, surface);
+            unsaved = true;
+        }
+
+        asio::post(m_io, [callback = std::move(request.callback), surface]()
+        {
+            callback(surface);
+        });
+    }
+
+    if (unsaved)
+        m_cache->save();
+}
@@ -0,0 +1,115 @@
+/*
+ * Copyright (C) 2026 Microchip Technology Inc.  All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#ifndef EGT_LAUNCHER_ICONLOADER_H
+#define EGT_LAUNCHER_ICONLOADER_H
+
+#include <cairo.h>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace asio
+{
+class io_context;
+}
+
+class IconCache;
+
+using IconSurface = std::shared_ptr<cairo_surface_t>;
+
+/**
+ * Create an image surface from a cairo surface, owning the reference.
+ */
+IconSurface make_icon_surface(cairo_surface_t* surface);
+
+/**
+ * Pixel memory of the image surfaces alive which were created with
+ * make_icon_surface().
+ */
+size_t icon_surface_bytes();
+
+/**
+ * Decode a PNG file and scale it to width x height, in CAIRO_FORMAT_ARGB32.
+ *
+ * Returns nullptr if the file cannot be decoded.
+ */
+IconSurface decode_icon(const std::string& path, int width, int height);
+
+/**
+ * Decodes launcher icons on a background thread.
+ *
+ * Requests are tagged with the page their item lives on. The worker always
+ * decodes the request closest to the focused page first: the current page,
+ * then its neighbours, then the rest. Completion callbacks are posted to the
+ * io_context of the UI thread.
+ *
+ * Decoded icons are added to the IconCache, if any, which is saved once
+ * the queue stayed empty for SAVE_DELAY, and when the loader is destroyed.
+ */
+class IconLoader
+{
+public:
+
+    /**
+     * Invoked on the UI thread, with nullptr if decoding failed.
+     */
+    using Callback = std::function<void(IconSurface surface)>;
+
+    explicit IconLoader(asio::io_context& io, IconCache* cache = nullptr);
+
+    IconLoader(const IconLoader&) = delete;
+    IconLoader& operator=(const IconLoader&) = delete;
+
+    ~IconLoader();
+
+    /**
+     * Queue the decoding of an icon.
+     *
+     * @param path Resolved file path of the icon.
+     */
+    void request(size_t page, const std::string& path, int width, int height,
+                 Callback callback);
+
+    /**
+     * Change the page whose icons are decoded first.
+     */
+    void focus(size_t page);
+
+    /// Time without requests before the icons decoded are saved.
+    static constexpr std::chrono::milliseconds SAVE_DELAY{1000};
+
+private:
+
+    struct Request
+    {
+        std::string path;
+        int width;
+        int height;
+        Callback callback;
+    };
+
+    bool next(Request& request);
+
+    void run();
+
+    asio::io_context& m_io;
+    IconCache* m_cache;
+    std::mutex m_mutex;
+    std::condition_variable m_cond;
+    /// Pending requests by page.
+    std::map<size_t, std::deque<Request>> m_pending;
+    size_t m_focus{0};
+    bool m_stop{false};
+    std::thread m_thread;
+};
+
+#endif
@@ -0,0 +1,196 @@
+/*
+ * Copyright (C) 2026 Microchip Technology Inc.  All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "keywatch.h"
+#include <array>
+#include <cerrno>
+#include <csignal>
+#include <cstdlib>
+#include <fcntl.h>
+#include <sys/epoll.h>
+#include <sys/syscall.h>
+#include <sys/timerfd.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#ifndef SYS_pidfd_open
+#define SYS_pidfd_open 434
+#endif
+#ifndef SYS_pidfd_send_signal
+#define SYS_pidfd_send_signal 424
+#endif
+
+const char* const EXIT_KEY_DEVICE = "/dev/input/keyboard0";
+const char* const EXIT_KEYS_ENV = "EGT_LAUNCHER_EXIT_KEYS";
+
+/// Liveness is polled at this interval on kernels without pidfd_open().
+static const int POLL_MS = 200;
+
+bool parse_key_codes(const std::string& list, KeyCodes& codes)
+{
+    codes.clear();
+
+    const char* p = list.c_str();
+    while (*p)
+    {
+        if (*p == ',' || *p == ' ' || *p == '\t' || *p == '\n')
+        {
+            ++p;
+            continue;
+        }
+
+        char* end = nullptr;
+        const auto code = std::strtoul(p, &end, 0);
+        if (end == p || code == 0 || code > KEY_MAX)
+        {
+            codes.clear();
+            return false;
+        }
+
+        codes.push_back(static_cast<uint16_t>(code));
+        p = end;
+    }
+
+    return true;
+}
+
+std::string format_key_codes(const KeyCodes& codes)
+{
+    std::string list;
+    for (auto code : codes)
+    {
+        if (!list.empty())
+            list += ',';
+        list += std::to_string(code);
+    }
+    return list;
+}
+
+bool is_exit_key(const struct input_event& event, const KeyCodes& keys)
+{
+    // 0 is a release, 2 an autorepeat
+    if (event.type != EV_KEY || event.value != 1)
+        return false;
+
+    if (keys.empty())
+        return event.code == KEY_0;
+
+    for (auto key : keys)
+    {
+        if (event.code == key)
+            return true;
+    }
+
+    return false;
+}
+
+/**
+ * Tell if a process, child or not, has not exited.
+ */
+static bool alive(pid_t pid)
+{
+    siginfo_t info{};
+    if (::waitid(P_PID, pid, &info, WEXITED | WNOHANG | WNOWAIT) == 0)
+        return info.si_pid == 0;
+
+    return ::kill(pid, 0) == 0 || errno == EPERM;
+}
+
+bool watch_exit_keys(pid_t pid, const KeyCodes& keys, std::chrono::milliseconds grace)
+{
+    const int pidfd = static_cast<int>(::syscall(SYS_pidfd_open, pid, 0));
+    const int keyboard = ::open(EXIT_KEY_DEVICE, O_RDONLY | O_NONBLOCK | O_CLOEXEC);
+    const int timer = ::timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+    const int epoll = ::epoll_create1(EPOLL_CLOEXEC);
+
+    auto add = [epoll](int fd)
+    {
+        if (fd < 0)
+            return;
+
+        struct epoll_event event {};
+        event.events = EPOLLIN;
+        event.data.fd = fd;
+        ::epoll_ctl(epoll, EPOLL_CTL_ADD, fd, &event);
+    };
+    add(pidfd);
+    add(keyboard);
+    add(timer);
+
+    auto send = [pid, pidfd](int signal)
+    {
+        if (pidfd >= 0)
+            ::syscall(SYS_pidfd_send_signal, pidfd, signal, nullptr, 0);
+        else
+            ::kill(pid, signal);
+    };
+
+    bool terminating = false;
+    bool exited = false;
+    while (!exited)
+    {
+        std::array<struct epoll_event, 4> events{};
+        const int n = ::epoll_wait(epoll, events.data(), events.size(), pidfd < 0 ? POLL_MS : -1);
+        if (n < 0 && errno != EINTR)
+            break;
+
+        if (pidfd < 0 && !alive(pid))
+            break;
+
+        for (int i = 0; i < n; ++i)
+        {
+            const int fd = events[i].data.fd;
+            if (fd == pidfd)
+            {
+                exited = true;
+            }
+            else if (fd == keyboard)
+            {
+                std::array<struct input_event, 16> input{};
+                const auto len = ::read(keyboard, input.data(), sizeof(input));
+                if (len < 0 && errno != EAGAIN && errno != EINTR)
+                {
+                    // unplugged, only wait for the exit from now on
+                    ::epoll_ctl(epoll, EPOLL_CTL_DEL, keyboard, nullptr);
+                    continue;
+                }
+
+                for (ssize_t e = 0; e < len / static_cast<ssize_t>(sizeof(input[0])); ++e)
+                {
+                    if (!terminating && is_exit_key(input[e], keys))
+                    {
+                        terminating = true;
+                        send(SIGTERM);
+
+                        struct itimerspec delay {};
+                        delay.it_value.tv_sec = grace.count() / 1000;
+                        delay.it_value.tv_nsec = (grace.count() % 1000) * 1000000;
+                        if (!delay.it_value.tv_sec && !delay.it_value.tv_nsec)
+                            delay.it_value.tv_nsec = 1;
+                        ::timerfd_settime(timer, 0, &delay, nullptr);
+                    }
+                }
+            }
+            else if (fd == timer)
+            {
+                uint64_t expirations = 0;
+                if (::read(timer, &expirations, sizeof(expirations)) > 0)
+                    send(SIGKILL);
+            }
+        }
+    }
+
+    for (int fd : {epoll, timer, keyboard, pidfd})
+    {
+        if (fd >= 0)
+            ::close(fd);
+    }
+
+    return terminating;
+}
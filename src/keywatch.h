@@ -0,0 +1,56 @@
+/*
+ * Copyright (C) 2026 Microchip Technology Inc.  All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#ifndef EGT_LAUNCHER_KEYWATCH_H
+#define EGT_LAUNCHER_KEYWATCH_H
+
+#include <chrono>
+#include <cstdint>
+#include <linux/input.h>
+#include <string>
+#include <sys/types.h>
+#include <vector>
+
+/**
+ * Codes of the keys which end an application, from
+ * linux/input-event-codes.h. Empty stands for KEY_0.
+ */
+using KeyCodes = std::vector<uint16_t>;
+
+/// Keyboard the exit keys are read from.
+extern const char* const EXIT_KEY_DEVICE;
+
+/// Environment variable passing the exit keys of an entry to launch.sh.
+extern const char* const EXIT_KEYS_ENV;
+
+/// Time an application is given to exit on SIGTERM, before SIGKILL.
+const std::chrono::milliseconds EXIT_GRACE{2000};
+
+/**
+ * Parse key codes separated by commas or spaces, returns false if invalid.
+ */
+bool parse_key_codes(const std::string& list, KeyCodes& codes);
+
+/**
+ * Key codes separated by commas, as read by parse_key_codes().
+ */
+std::string format_key_codes(const KeyCodes& codes);
+
+/**
+ * Tell if an input event presses one of the keys.
+ */
+bool is_exit_key(const struct input_event& event, const KeyCodes& keys);
+
+/**
+ * Wait for a process to exit, ending it once one of the keys is pressed on
+ * the keyboard: SIGTERM first, then SIGKILL if still alive after grace.
+ *
+ * The process is signalled through a pidfd, so a recycled pid is never
+ * hit, and is not reaped. Without a keyboard this only waits. Returns true
+ * if the process was ended with a key.
+ */
+bool watch_exit_keys(pid_t pid, const KeyCodes& keys, std::chrono::milliseconds grace);
+
+#endif
@@ -0,0 +1,90 @@
+/*
+ * Copyright (C) 2026 Microchip Technology Inc.  All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "latency.h"
+#include <algorithm>
+
+static uint64_t to_us(LatencyTracker::Clock::duration d)
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(d).count();
+}
+
+LatencyTracker::LatencyTracker()
+{
+    // events are tracked without allocating
+    m_pending.reserve(MAX_PENDING);
+}
+
+void LatencyTracker::input(InputKind kind, Clock::time_point when)
+{
+    if (m_pending.size() >= MAX_PENDING)
+    {
+        m_stats[static_cast<size_t>(m_pending.front().kind)].unpresented++;
+        m_pending.erase(m_pending.begin());
+    }
+
+    m_pending.push_back({kind, when, false});
+}
+
+void LatencyTracker::handled(InputKind kind, Clock::time_point when)
+{
+    auto pending = std::find_if(m_pending.rbegin(), m_pending.rend(), [kind](const Pending & p)
+    {
+        return p.kind == kind;
+    });
+    if (pending == m_pending.rend() || pending->handled)
+        return;
+
+    pending->handled = true;
+    m_stats[static_cast<size_t>(kind)].handler.record(to_us(when - pending->input));
+}
+
+void LatencyTracker::presented(Clock::time_point start, Clock::time_point now)
+{
+    m_pending.erase(std::remove_if(m_pending.begin(), m_pending.end(), [&](const Pending & p)
+    {
+        auto& stats = m_stats[static_cast<size_t>(p.kind)];
+        if (p.input <= start)
+        {
+            stats.photon.record(to_us(now - p.input));
+            return true;
+        }
+
+        if (now - p.input > MAX_WAIT)
+        {
+            stats.unpresented++;
+            return true;
+        }
+
+        return false;
+    }), m_pending.end());
+}
+
+void LatencyTracker::report(std::ostream& out) const
+{
+    static const std::array<const char*, 4> names =
+    {
+        "pointer_down", "pointer_up", "click", "drag",
+    };
+
+    for (size_t i = 0; i < m_stats.size(); ++i)
+    {
+        auto& s = m_stats[i];
+        out << names[i] << " events=" << s.photon.count() + s.unpresented
+            << " unpresented=" << s.unpresented;
+        for (auto& [histogram, kind] : {std::make_pair(&s.handler, "handler"), std::make_pair(&s.photon, "photon")})
+        {
+            out << " " << kind << "_p50_us=" << histogram->percentile(0.50)
+                << " " << kind << "_p95_us=" << histogram->percentile(0.95)
+                << " " << kind << "_p99_us=" << histogram->percentile(0.99);
+        }
+        out << "\n";
+    }
+    out.flush();
+}
@@ -0,0 +1,95 @@
+/*
+ * Copyright (C) 2026 Microchip Technology Inc.  All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#ifndef EGT_LAUNCHER_LATENCY_H
+#define EGT_LAUNCHER_LATENCY_H
+
+#include "histogram.h"
+#include <array>
+#include <chrono>
+#include <ostream>
+#include <vector>
+
+/**
+ * Kind of input event whose latency is tracked.
+ */
+enum class InputKind
+{
+    pointer_down,
+    pointer_up,
+    click,
+    drag,
+};
+
+/**
+ * Input to photon latency of the launcher.
+ *
+ * Each input event is stamped when it reaches the launcher. Two latencies
+ * are then measured from that stamp: until a handler reacts to it, and
+ * until the first frame started after it is on screen. Both are kept in a
+ * histogram per kind of event.
+ *
+ * Events still waiting for a frame after MAX_WAIT are counted as not
+ * presented, as they did not change anything on screen.
+ */
+class LatencyTracker
+{
+public:
+
+    using Clock = std::chrono::steady_clock;
+
+    static constexpr std::chrono::seconds MAX_WAIT{1};
+
+    LatencyTracker();
+
+    /**
+     * An input event reached the launcher.
+     */
+    void input(InputKind kind, Clock::time_point when);
+
+    /**
+     * A handler reacted to the last input of that kind.
+     *
+     * Does nothing if that input was already handled.
+     */
+    void handled(InputKind kind, Clock::time_point when);
+
+    /**
+     * A frame, whose drawing started at start, is on screen.
+     */
+    void presented(Clock::time_point start, Clock::time_point now);
+
+    /**
+     * Write percentiles, one line per kind of event.
+     */
+    void report(std::ostream& out) const;
+
+    const Histogram& handler(InputKind kind) const { return m_stats[static_cast<size_t>(kind)].handler; }
+    const Histogram& photon(InputKind kind) const { return m_stats[static_cast<size_t>(kind)].photon; }
+
+private:
+
+    /// Past this many events waiting for a frame, the oldest ones are dropped.
+    static constexpr size_t MAX_PENDING = 64;
+
+    struct Pending
+    {
+        InputKind kind;
+        Clock::time_point input;
+        bool handled;
+    };
+
+    struct Stats
+    {
+        Histogram handler;
+        Histogram photon;
+        uint64_t unpresented{0};
+    };
+
+    std::array<Stats, 4> m_stats;
+    std::vector<Pending> m_pending;
+};
+
+#endif
@@ -7,19 +7,47 @@
 #include "config.h"
 #endif
 
+#include "allocstats.h"
+#include "display.h"
+#include "exitkey.h"
+#include "framestats.h"
+#include "hud.h"
+#include "iconcache.h"
+#include "iconloader.h"
+#include "latency.h"
+#include "launchtiming.h"
+#include "manifest.h"
+#include "memreport.h"
+#include "metrics.h"
+#include "options.h"
+#include "prefetch.h"
+#include "process.h"
+#include "profiler.h"
+#include "scanner.h"
+#include "snapshot.h"
+#include "supervisor.h"
+#include "trace.h"
+#include "watcher.h"
 #include <algorithm>
 #include <array>
+#include <cerrno>
 #include <cmath>
+#include <csignal>
+#include <cstring>
+#include <egt/asio.hpp>
 #include <egt/detail/filesystem.h>
 #include <egt/ui>
 #include <filesystem>
 #include <fstream>
 #include <iostream>
+#include <map>
 #include <memory>
-#include <rapidxml.hpp>
-#include <rapidxml_utils.hpp>
-#include <regex>
 #include <string>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 #ifdef HAVE_EGT_DETAIL_SCREEN_KMSSCREEN_H
@@ -140,6 +168,17 @@ static const Layout portrait_layout =
     },
 };
 
+/**
+ * Direction of a swipe.
+ */
+enum class SwipeDirection
+{
+    left,
+    right,
+    up,
+    down,
+};
+
 /**
  * Basic swipe detector which will invoke a callback with up/down/left/right.
  */
@@ -147,7 +186,7 @@ class SwipeDetect
 {
 public:
 
-    using SwipeCallback = std::function<void(const std::string& direction)>;
+    using SwipeCallback = std::function<void(SwipeDirection direction)>;
 
     SwipeDetect() = delete;
 
@@ -174,9 +213,9 @@ public:
                 const auto dist = m_start - event.pointer().point;
 
                 if (std::abs(dist.x()) >= m_threshold && std::abs(dist.y()) <= m_restraint)
-                    m_callback((dist.x() < 0) ? "left" : "right");
+                    m_callback((dist.x() < 0) ? SwipeDirection::left : SwipeDirection::right);
                 else if (std::abs(dist.y()) >= m_threshold && std::abs(dist.x()) <= m_restraint)
-                    m_callback((dist.y() < 0) ? "up" : "down");
+                    m_callback((dist.y() < 0) ? SwipeDirection::up : SwipeDirection::down);
             };
 
             break;
@@ -260,6 +299,30 @@ static std::string exec(const char* cmd, bool wait = false)
 
 class LauncherWindow;
 
+/**
+ * Kind of an input event tracked by LatencyTracker, returns false for others.
+ */
+static bool input_kind(egt::EventId id, InputKind& kind)
+{
+    switch (id)
+    {
+    case egt::EventId::raw_pointer_down:
+        kind = InputKind::pointer_down;
+        return true;
+    case egt::EventId::raw_pointer_up:
+        kind = InputKind::pointer_up;
+        return true;
+    case egt::EventId::pointer_click:
+        kind = InputKind::click;
+        return true;
+    case egt::EventId::pointer_drag:
+        kind = InputKind::drag;
+        return true;
+    default:
+        return false;
+    }
+}
+
 /**
  * Add a property.
  */
@@ -272,6 +335,22 @@ static egt::Serializer::Properties& add_prop(egt::Serializer::Properties& props,
     return props;
 }
 
+/**
+ * Estimate of the memory held by properties.
+ */
+static uint64_t properties_bytes(const egt::Serializer::Properties& props)
+{
+    uint64_t bytes = props.capacity() * sizeof(props[0]);
+    for (const auto& [name, value, attrs] : props)
+    {
+        bytes += MemoryReport::heap_bytes(name) + MemoryReport::heap_bytes(value) +
+                 attrs.capacity() * sizeof(attrs[0]);
+        for (const auto& [key, attr] : attrs)
+            bytes += MemoryReport::heap_bytes(key) + MemoryReport::heap_bytes(attr);
+    }
+    return bytes;
+}
+
 /*
  * A launcher menu item.
  */
@@ -290,6 +369,63 @@ public:
 
     void handle(egt::Event& event) override;
 
+    /**
+     * Show another entry, when recycled by a virtualized Pager.
+     */
+    void entry(const ManifestEntry& entry)
+    {
+        text(entry.title);
+        m_description = entry.description;
+        m_exec = entry.arg;
+        command(entry);
+    }
+
+    /**
+     * Take the command split into words, the exit keys and the restart
+     * policy of an entry.
+     */
+    void command(const ManifestEntry& entry)
+    {
+        m_argv = entry.argv;
+        m_exit_keys = entry.exit_keys;
+        m_restart = entry.restart;
+    }
+
+    /**
+     * Command split into words, empty if it needs a shell.
+     */
+    const std::vector<std::string>& argv() const
+    {
+        return m_argv;
+    }
+
+    /**
+     * Image file of the entry, as found in the manifest.
+     */
+    void icon(const std::string& image)
+    {
+        m_icon = image;
+    }
+
+    const std::string& icon() const
+    {
+        return m_icon;
+    }
+
+    /**
+     * Estimate of the memory held by the item, its image aside.
+     */
+    uint64_t memory_bytes() const
+    {
+        uint64_t bytes = sizeof(*this) + MemoryReport::heap_bytes(text()) +
+                         MemoryReport::heap_bytes(m_description) + MemoryReport::heap_bytes(m_exec) +
+                         MemoryReport::heap_bytes(m_icon) + m_argv.capacity() * sizeof(std::string) +
+                         m_exit_keys.capacity() * sizeof(uint16_t);
+        for (const auto& word : m_argv)
+            bytes += MemoryReport::heap_bytes(word);
+        return bytes;
+    }
+
 private:
 
     void deserialize(egt::Serializer::Properties& props)
@@ -317,6 +453,10 @@ private:
     LauncherWindow& m_window;
     std::string m_description;
     std::string m_exec;
+    std::vector<std::string> m_argv;
+    KeyCodes m_exit_keys;
+    RestartPolicy m_restart{RestartPolicy::home};
+    std::string m_icon;
 };
 
 /**
@@ -326,21 +466,36 @@ class Pager : public egt::ScrolledView
 {
 public:
     using PageAddedCallback = std::function<void (void)>;
+    using PageRemovedCallback = std::function<void (void)>;
     using PageChangedCallback = std::function<void (size_t)>;
+    using ItemFactory = std::function<std::shared_ptr<Widget> (void)>;
+    using ItemBinder = std::function<void (const std::shared_ptr<Widget>&, size_t)>;
 
     Pager(egt::Serializer::Properties& props,
           const egt::Serializer::Properties& grid_props,
           const PageAddedCallback& on_page_added,
+          const PageRemovedCallback& on_page_removed,
           const PageChangedCallback& on_page_changed) :
         ScrolledView(props, true),
         m_grid_props(grid_props),
         m_sizer(egt::Orientation::horizontal, egt::Justification::start),
         m_animator(std::chrono::milliseconds(1)),
         m_on_page_added(on_page_added),
+        m_on_page_removed(on_page_removed),
         m_on_page_changed(on_page_changed)
     {
+        for (auto& p : m_grid_props)
+        {
+            if (std::get<0>(p) == "n_col")
+                m_n_col = std::stoul(std::get<1>(p));
+            else if (std::get<0>(p) == "n_row")
+                m_n_row = std::stoul(std::get<1>(p));
+        }
+
         m_animator.on_change([this](egt::DefaultDim value)
         {
+            AllocStats::Scope alloc("page_turn");
+            Tracer::instance().counter("pager_position", "animation", value);
             position(value);
             if (!m_animator.running())
                 m_on_page_changed(page());
@@ -356,15 +511,25 @@ public:
         deserialize_leaf(props);
     }
 
+    void layout() override
+    {
+        Tracer::Scope trace("layout", "layout", "pager");
+        ScrolledView::layout();
+    }
+
     void handle(egt::Event& event) override
     {
+        AllocStats::Scope alloc("pager");
+
         switch (event.id())
         {
         case egt::EventId::pointer_drag_start:
             m_animator.stop();
+            m_dragging = true;
             break;
         case egt::EventId::pointer_drag_stop:
         {
+            m_dragging = false;
             if (!m_animator.running())
             {
                 auto_scroll([](float f) { return std::round(f); });
@@ -376,6 +541,9 @@ public:
         }
 
         ScrolledView::handle(event);
+
+        if (event.id() == egt::EventId::pointer_drag)
+            materialize();
     }
 
     void page(size_t page_index)
@@ -402,13 +570,282 @@ public:
         auto_scroll([](float f) { return std::floor(f); });
     }
 
-    void add_item(const std::shared_ptr<Widget>& item)
+    /**
+     * Create the item widgets on demand, instead of holding all of them.
+     *
+     * Only the current page and one page on each side get a grid, and their
+     * items are recycled as the pager scrolls: factory creates a blank item
+     * and binder shows the item of an index in it. Items are then counted
+     * with count() instead of being added.
+     */
+    void virtualize(ItemFactory factory, ItemBinder binder)
+    {
+        m_factory = std::move(factory);
+        m_binder = std::move(binder);
+
+        // a single empty frame gives the extent of all the pages
+        remove(&m_sizer);
+        add(m_extent);
+    }
+
+    bool virtualized() const
+    {
+        return bool(m_factory);
+    }
+
+    /**
+     * Set the number of items of a virtualized pager.
+     *
+     * The visible items are all bound again, as any of them may have
+     * changed.
+     */
+    void count(size_t count)
+    {
+        const auto old_pages = page_count();
+        const auto current = page();
+
+        m_count = count;
+        const auto pages = page_count();
+        for (auto index = old_pages; index < pages; ++index)
+            m_on_page_added();
+        for (auto index = pages; index < old_pages; ++index)
+            m_on_page_removed();
+
+        const auto plen = page_length();
+        const auto extent = plen * static_cast<egt::DefaultDim>(std::max<size_t>(pages, 1));
+        if (m_landscape)
+            m_extent.resize(egt::Size(extent, content_area().height()));
+        else
+            m_extent.resize(egt::Size(content_area().width(), extent));
+
+        materialize(true);
+
+        if (pages && current >= pages)
+            page(pages - 1);
+    }
+
+    /**
+     * Add an item to the first page with a free cell.
+     *
+     * Returns the index of that page.
+     */
+    size_t add_item(const std::shared_ptr<Widget>& item)
     {
-        egt::StaticGrid* page = first_available_page();
+        size_t index = 0;
+        egt::StaticGrid* page = first_available_page(index);
         if (!page)
             page = add_page();
 
         page->add(item);
+        m_items.push_back(item);
+        return index;
+    }
+
+    /**
+     * Append items after the existing ones.
+     *
+     * The page of each item follows from its index, and all the pages needed
+     * are created up front. The grids are filled while hidden, so they are
+     * laid out once at the end instead of once per item.
+     */
+    void add_items(const std::vector<std::shared_ptr<Widget>>& items)
+    {
+        if (items.empty())
+            return;
+
+        const auto per_page = items_per_page();
+        const auto first = m_items.size();
+        const auto first_page = first / per_page;
+        const auto pages = (first + items.size() + per_page - 1) / per_page;
+
+        m_sizer.hide();
+
+        std::vector<egt::StaticGrid*> grids;
+        for (auto index = first_page; index < pages; ++index)
+        {
+            auto* grid = (index < page_count()) ? &page_at(index) : add_page();
+            grid->hide();
+            grids.push_back(grid);
+        }
+
+        // pages are always filled in order, so the free cells are the last ones
+        for (size_t i = 0; i < items.size(); ++i)
+            grids[(first + i) / per_page - first_page]->add(items[i]);
+
+        m_items.insert(m_items.end(), items.begin(), items.end());
+
+        Tracer::Scope trace("layout", "layout", "add_items");
+
+        for (auto* grid : grids)
+        {
+            grid->show();
+            grid->layout();
+        }
+
+        m_sizer.show();
+        m_sizer.layout();
+    }
+
+    /**
+     * Replace all the items.
+     *
+     * Only the pages whose content changed are reflowed, and the current
+     * page index is kept as long as that page still exists.
+     */
+    void update(std::vector<std::shared_ptr<Widget>> items)
+    {
+        const auto per_page = items_per_page();
+        const auto pages = (items.size() + per_page - 1) / per_page;
+        const auto current = page();
+
+        auto slice = [per_page](const std::vector<std::shared_ptr<Widget>>& v, size_t page)
+        {
+            const auto begin = std::min(page * per_page, v.size());
+            const auto end = std::min(begin + per_page, v.size());
+            return std::make_pair(v.begin() + begin, v.begin() + end);
+        };
+
+        std::vector<size_t> touched;
+        for (size_t index = 0; index < std::max(pages, page_count()); ++index)
+        {
+            auto [old_begin, old_end] = slice(m_items, index);
+            auto [new_begin, new_end] = slice(items, index);
+            if (!std::equal(old_begin, old_end, new_begin, new_end))
+                touched.push_back(index);
+        }
+
+        // detach first, as items may move to an earlier page
+        for (auto index : touched)
+        {
+            if (index >= page_count())
+                break;
+
+            auto& grid = page_at(index);
+            const auto children = grid.children();
+            for (auto& child : children)
+                grid.remove(child.get());
+        }
+
+        for (auto index : touched)
+        {
+            if (index >= pages)
+                break;
+
+            auto* grid = (index < page_count()) ? &page_at(index) : add_page();
+            auto [begin, end] = slice(items, index);
+            for (auto i = begin; i != end; ++i)
+                grid->add(*i);
+        }
+
+        while (page_count() > pages)
+        {
+            m_sizer.remove(m_sizer.children().back().get());
+            m_on_page_removed();
+        }
+
+        m_items = std::move(items);
+
+        if (pages)
+            page(std::min(current, pages - 1));
+    }
+
+    /**
+     * Tell if the pager follows the pointer.
+     */
+    bool dragging() const
+    {
+        return m_dragging;
+    }
+
+    /**
+     * Tell if the pager scrolls to a page on its own.
+     */
+    bool animating() const
+    {
+        return m_animator.running();
+    }
+
+    size_t item_count() const
+    {
+        if (virtualized())
+            return m_count;
+
+        return m_items.size();
+    }
+
+    /**
+     * Items which exist as widgets, shown or not.
+     */
+    std::vector<std::shared_ptr<Widget>> items() const
+    {
+        if (!virtualized())
+            return m_items;
+
+        auto items = m_spare;
+        for (const auto& view : m_views)
+        {
+            const auto& children = view.grid->children();
+            items.insert(items.end(), children.begin(), children.end());
+        }
+        return items;
+    }
+
+    /**
+     * Items of a page, none if it has no widgets.
+     */
+    std::vector<std::shared_ptr<Widget>> page_items(size_t page_index) const
+    {
+        if (!virtualized())
+        {
+            if (page_index >= page_count())
+                return {};
+            return page_at(page_index).children();
+        }
+
+        for (const auto& view : m_views)
+        {
+            if (view.page == page_index)
+                return view.grid->children();
+        }
+        return {};
+    }
+
+    /**
+     * Account the grids of the pages, and the lists of items.
+     */
+    void memory(MemoryReport& report) const
+    {
+        auto grid_bytes = [](const egt::StaticGrid & grid)
+        {
+            return sizeof(grid) + grid.children().capacity() * sizeof(std::shared_ptr<Widget>);
+        };
+
+        if (virtualized())
+        {
+            for (const auto& view : m_views)
+                report.add("pages", grid_bytes(*view.grid));
+        }
+        else
+        {
+            for (size_t index = 0; index < page_count(); ++index)
+                report.add("pages", grid_bytes(page_at(index)));
+        }
+
+        report.add("pages", (m_items.capacity() + m_spare.capacity()) * sizeof(std::shared_ptr<Widget>) +
+                   m_views.capacity() * sizeof(View), 0);
+    }
+
+    size_t items_per_page() const
+    {
+        return std::max<size_t>(m_n_col * m_n_row, 1);
+    }
+
+    size_t page_count() const
+    {
+        if (virtualized())
+            return (m_count + items_per_page() - 1) / items_per_page();
+
+        return m_sizer.count_children();
     }
 
 protected:
@@ -423,16 +860,129 @@ protected:
         return grid.get();
     }
 
-    egt::StaticGrid* first_available_page() const
+    egt::StaticGrid& page_at(size_t index) const
+    {
+        return *static_cast<egt::StaticGrid*>(m_sizer.child_at(index).get());
+    }
+
+    /**
+     * Items are only appended, or packed again by update(), so every page
+     * before the last one is full.
+     */
+    egt::StaticGrid* first_available_page(size_t& index) const
+    {
+        index = m_items.size() / items_per_page();
+        if (index < page_count())
+            return &page_at(index);
+
+        return nullptr;
+    }
+
+    /**
+     * Grid of a virtualized pager, showing one page at a time.
+     */
+    struct View
+    {
+        std::shared_ptr<egt::StaticGrid> grid;
+        /// Page shown, NO_PAGE if none.
+        size_t page;
+    };
+
+    static constexpr size_t NO_PAGE = static_cast<size_t>(-1);
+
+    /**
+     * Give a grid to the current page and its neighbours, recycling the
+     * grids of the pages scrolled away.
+     *
+     * Nothing is done unless the current page changed, or rebind is set.
+     */
+    void materialize(bool rebind = false)
     {
-        for (auto& child : m_sizer.children())
+        if (!virtualized())
+            return;
+
+        const auto pages = page_count();
+        const auto current = page();
+        if (!rebind && current == m_materialized)
+            return;
+        m_materialized = current;
+
+        const auto first = current ? current - 1 : 0;
+        const auto last = std::min(current + 2, pages);
+
+        for (auto& view : m_views)
         {
-            auto* p = static_cast<egt::StaticGrid*>(child.get());
-            if (p->count_children() < (p->n_col() * p->n_row()))
-                return p;
+            if (view.page < first || view.page >= last)
+                view.page = NO_PAGE;
         }
 
-        return nullptr;
+        for (auto index = first; index < last; ++index)
+        {
+            auto view = std::find_if(m_views.begin(), m_views.end(),
+                                     [index](const View & v) { return v.page == index; });
+            if (view != m_views.end() && !rebind)
+                continue;
+
+            if (view == m_views.end())
+            {
+                view = std::find_if(m_views.begin(), m_views.end(),
+                                    [](const View & v) { return v.page == NO_PAGE; });
+            }
+
+            if (view == m_views.end())
+            {
+                auto props = m_grid_props;
+                auto grid = std::make_shared<egt::StaticGrid>(props);
+                grid->resize(content_area().size());
+                add(grid);
+                m_views.push_back({grid, NO_PAGE});
+                view = m_views.end() - 1;
+            }
+
+            view->page = index;
+            bind_page(*view);
+        }
+
+        for (auto& view : m_views)
+        {
+            if (view.page == NO_PAGE)
+                view.grid->hide();
+        }
+    }
+
+    /**
+     * Show the items of the page of a view in its grid.
+     */
+    void bind_page(View& view)
+    {
+        auto& grid = *view.grid;
+        const auto begin = view.page * items_per_page();
+        const auto end = std::min(begin + items_per_page(), m_count);
+
+        while (grid.count_children() > end - begin)
+        {
+            auto item = grid.child_at(grid.count_children() - 1);
+            grid.remove(item.get());
+            m_spare.push_back(item);
+        }
+
+        while (grid.count_children() < end - begin)
+        {
+            if (m_spare.empty())
+                grid.add(m_factory());
+            else
+            {
+                grid.add(m_spare.back());
+                m_spare.pop_back();
+            }
+        }
+
+        for (auto index = begin; index < end; ++index)
+            m_binder(grid.child_at(index - begin), index);
+
+        const auto origin = page_length() * static_cast<egt::DefaultDim>(view.page);
+        grid.move(m_landscape ? egt::Point(origin, 0) : egt::Point(0, origin));
+        grid.show();
     }
 
     void position(egt::DefaultDim value)
@@ -443,17 +993,21 @@ protected:
         else
             p.y(value);
         offset(p);
+        materialize();
     }
 
     EGT_NODISCARD egt::DefaultDim position() const { return to_dim(offset()); }
 
     EGT_NODISCARD egt::DefaultDim page_length() const { return to_dim(content_area().size()); }
 
-    void auto_scroll(const std::function<float(float)>& func)
+    /**
+     * Animate to the page given by rounding the current fractional page.
+     */
+    void auto_scroll(float (*round)(float))
     {
         const auto plen = page_length();
         const auto start = position();
-        const auto end = plen * static_cast<egt::DefaultDim>(func(static_cast<float>(start) / static_cast<float>(plen)));
+        const auto end = plen * static_cast<egt::DefaultDim>(round(static_cast<float>(start) / static_cast<float>(plen)));
         m_animator.duration(std::chrono::milliseconds(std::abs(end - start) / m_pixels_per_milliseconds));
         m_animator.starting(start);
         m_animator.ending(end);
@@ -504,7 +1058,22 @@ private:
     egt::BoxSizer m_sizer;
     egt::PropertyAnimator m_animator;
     PageAddedCallback m_on_page_added;
+    PageRemovedCallback m_on_page_removed;
     PageChangedCallback m_on_page_changed;
+    /// All the items, in page order.
+    std::vector<std::shared_ptr<Widget>> m_items;
+    /// Virtualized mode: item count, grids of the visible pages, unused items.
+    ItemFactory m_factory;
+    ItemBinder m_binder;
+    size_t m_count{0};
+    egt::Frame m_extent;
+    std::vector<View> m_views;
+    std::vector<std::shared_ptr<Widget>> m_spare;
+    size_t m_materialized{NO_PAGE};
+    size_t m_n_col{1};
+    size_t m_n_row{1};
+
+    bool m_dragging{false};
 
     bool m_landscape{true};
     egt::DefaultDim m_pixels_per_milliseconds{2};
@@ -512,26 +1081,79 @@ private:
 
 const auto PAGE_FILENAME = "/tmp/egt-launcher-page";
 
+/// Arguments of the launcher, quoted for launch.sh to start it again.
+const auto LAUNCHER_ARGS_ENV = "EGT_LAUNCHER_ARGS";
+
+/// A press not confirmed by a click within this time is not a launch.
+const std::chrono::milliseconds SPECULATION_TIMEOUT{1000};
+
+/// A press held this long without a drag is forked ahead with --prefork.
+const std::chrono::milliseconds PREFORK_DELAY{80};
+
+/// Time without input before the applications of the page are read ahead.
+const std::chrono::milliseconds READAHEAD_DELAY{1500};
+
+/// Time after a change of the frame before it is saved as the snapshot.
+const std::chrono::milliseconds SNAPSHOT_DELAY{2000};
+
+static size_t read_page_index()
+{
+    size_t page = 0;
+    std::ifstream in(PAGE_FILENAME);
+    if (in.is_open())
+        in >> page;
+    return page;
+}
+
+/**
+ * Name of the snapshot file, for a layout at the current screen size.
+ */
+static std::string snapshot_name(const Layout& layout)
+{
+    const auto size = egt::Application::instance().screen()->size();
+    return "snapshot-" + std::to_string(size.width()) + "x" + std::to_string(size.height()) +
+           (layout.landscape ? "-landscape" : "-portrait");
+}
+
 /**
  * Main launcher window.
  */
 class LauncherWindow : public egt::TopWindow
 {
 public:
-    LauncherWindow(const Layout& layout) :
+    LauncherWindow(const Layout& layout, const Options& options, Profiler& profiler) :
         m_layout(layout),
-        m_indicator_group(true, true)
+        m_options(options),
+        m_profiler(profiler),
+        m_indicator_group(true, true),
+        m_manifests(cache_file(options.cache_dir, "manifests")),
+        m_icon_cache(cache_file(options.cache_dir, "icons"), icon_size(), icon_size()),
+        m_snapshot(options.snapshot ? cache_file(options.cache_dir, snapshot_name(layout)) : std::string())
     {
+        m_manifests.open();
+        m_icon_cache.open();
+
         /* If not visible, layout() is not executed when adding child. */
         show();
 
-        background(egt::Image(std::string("file:") + m_layout.background));
+        // the snapshot stands for the whole window until drop_snapshot()
+        auto frame = m_snapshot.open(width(), height(), read_page_index());
+        if (frame)
+        {
+            Profiler::Scope phase(m_profiler, "snapshot");
+            show_background(egt::Image(frame));
+            egt::Application::instance().event().draw();
+            m_snapshot_shown = true;
+        }
+        else
+            show_background(egt::Image(std::string("file:") + m_layout.background));
 
         auto mchp_logo_props = m_layout.mchp_logo;
         add_prop(mchp_logo_props, "image", "icon:microchip_logo_white.png;128");
         add_prop(mchp_logo_props, "showlabel", "false");
         add_prop(mchp_logo_props, "image_align", "center|expand");
         auto logo = std::make_shared<egt::ImageLabel>(mchp_logo_props);
+        m_mchp_logo = logo.get();
         add(logo);
 
         auto mgs_logo_props = m_layout.mgs_logo;
@@ -539,6 +1161,7 @@ public:
         add_prop(mgs_logo_props, "showlabel", "false");
         add_prop(mgs_logo_props, "image_align", "center|expand");
         auto mgs_logo = std::make_shared<egt::ImageLabel>(mgs_logo_props);
+        m_mgs_logo = mgs_logo.get();
         add(mgs_logo);
 
         auto indicator_props = m_layout.indicator;
@@ -548,134 +1171,980 @@ public:
 
         auto pager_props = m_layout.pager;
         auto padded = [this]() { on_page_added(); };
+        auto premoved = [this]() { on_page_removed(); };
         auto pchanged = [this](size_t page_index) { on_page_changed(page_index); };
-        auto pager = std::make_shared<Pager>(pager_props, m_layout.grid, padded, pchanged);
+        auto pager = std::make_shared<Pager>(pager_props, m_layout.grid, padded, premoved, pchanged);
         m_pager = pager.get();
         add(pager);
-    }
 
-    void prev_page()
-    {
-        m_pager->prev_page();
-    }
+        m_hud = std::make_shared<PerfHud>(egt::Rect(8, 8, 300, 94), m_icon_cache);
+        add(m_hud);
+        if (m_options.hud)
+            m_hud->toggle();
 
-    void next_page()
-    {
-        m_pager->next_page();
-    }
+        if (m_options.lazy_pages)
+        {
+            m_pager->virtualize([this]() { return create_item(); },
+                                [this](const std::shared_ptr<egt::Widget>& item, size_t index)
+            {
+                bind_item(std::static_pointer_cast<LauncherItem>(item), index);
+            });
+        }
 
-    void on_page_added()
-    {
-        const auto s = m_indicator_sizer->height();
+        if (m_options.frame_stats)
+            m_frame_stats = std::make_unique<FrameStats>();
 
-        auto radio = std::make_shared<egt::RadioBox>();
-        radio->disable();
-        radio->show_label(false);
-        radio->autoresize(false);
-        radio->resize({s, s});
-        m_indicator_group.add(radio);
-        m_indicator_sizer->add(radio);
-    }
+        if (m_options.input_latency)
+        {
+            m_latency = std::make_unique<LatencyTracker>();
 
-    void on_page_changed(size_t page_index)
-    {
-        auto& radio = *static_cast<egt::RadioBox*>(m_indicator_sizer->child_at(page_index).get());
-        radio.checked(true);
-    }
+            // global handlers see events before any widget
+            egt::Input::global_input().on_event([this](egt::Event & event)
+            {
+                InputKind kind;
+                if (input_kind(event.id(), kind))
+                    m_latency->input(kind, std::chrono::steady_clock::now());
+            }, {egt::EventId::raw_pointer_down, egt::EventId::raw_pointer_up,
+                egt::EventId::pointer_click, egt::EventId::pointer_drag
+               });
+        }
 
-    void launch(const std::string& exe) const
-    {
-        egt::Application::instance().event().quit();
+        if (m_options.launch_timing)
+        {
+            auto& io = egt::Application::instance().event().io();
+            m_ready = std::make_unique<ReadyPipe>(io);
+            m_launch_history = std::make_unique<LaunchHistory>(
+                                   cache_file(m_options.cache_dir, "launches"));
+            m_launch_history->open();
+        }
 
-#ifdef HAVE_EGT_DETAIL_SCREEN_KMSSCREEN_H
-        // explicitly close KMS
-        if (egt::detail::KMSScreen::instance())
-            egt::detail::KMSScreen::instance()->close();
-#endif
+        if (!m_options.metrics.empty())
+        {
+            m_metrics = std::make_unique<MetricsServer>(egt::Application::instance().event().io(),
+                                                        m_options.metrics,
+                                                        [this]() { return metrics(); });
+        }
 
-        save_page_index();
+        if (m_frame_stats || m_latency || AllocStats::enabled() || m_options.memory_report)
+        {
+            auto& io = egt::Application::instance().event().io();
+            m_report_signal = std::make_unique<asio::signal_set>(io, SIGUSR1);
+            wait_report_signal();
+        }
 
-        const std::string cmd = DATADIR "/egt/launcher/launch.sh " + exe + " &";
-        exec(cmd.c_str());
+        if (m_options.watch)
+        {
+            m_watcher = std::make_unique<Watcher>(egt::Application::instance().event().io(),
+                                                  m_options.scan.suffix,
+                                                  std::chrono::milliseconds(250),
+                                                  std::chrono::milliseconds(2000),
+                                                  [this]() { reload(); });
+        }
     }
 
-    static std::vector<std::string> get_files(const std::string& dir)
+    void draw(egt::Painter& painter, const egt::Rect& rect) override
     {
-        std::vector<std::string> files;
+        AllocStats::Scope alloc("draw");
+        Tracer::Scope trace("draw", "draw");
+        const auto start = std::chrono::steady_clock::now();
+        egt::TopWindow::draw(painter, rect);
 
-        try
-        {
-            if (std::filesystem::exists(dir) && std::filesystem::is_directory(dir))
-            {
-                std::filesystem::recursive_directory_iterator iter(dir);
-                std::filesystem::recursive_directory_iterator end;
+        // the overlay must not account its own refreshes
+        const bool hud_only = m_hud->covers(rect);
 
-                while (iter != end)
-                {
-                    if (!std::filesystem::is_directory(iter->path().string()))
-                    {
-                        std::regex rx(".*\\.xml$");
-                        if (std::regex_match(iter->path().string(), rx))
-                            files.push_back(iter->path().string());
-                    }
-
-                    std::error_code ec;
-                    iter.increment(ec);
-                    if (ec)
-                    {
-                        std::cerr << "error accessing: " <<
-                                  iter->path().string() << " :: " << ec.message() << std::endl;
-                    }
-                }
+        if (m_frame_stats && !hud_only)
+            m_frame_stats->rendered(frame_activity(), start, std::chrono::steady_clock::now());
+
+        if (!hud_only && !tagline_only(rect))
+            schedule_snapshot();
+
+        // the window is drawn once per damaged rectangle, but the frame is
+        // on screen once the event loop is done with all of them
+        if (m_frame_pending)
+        {
+            m_frame_hud_only = m_frame_hud_only && hud_only;
+        }
+        else if (m_frame_stats || m_latency || m_hud->visible() || m_profiler.running("first_frame"))
+        {
+            m_frame_pending = true;
+            m_frame_hud_only = hud_only;
+            asio::post(egt::Application::instance().event().io(), [this, start]()
+            {
+                m_frame_pending = false;
+                presented(start, std::chrono::steady_clock::now());
+            });
+        }
+    }
+
+    /**
+     * A frame, whose drawing started at start, is on screen.
+     */
+    void presented(std::chrono::steady_clock::time_point start,
+                   std::chrono::steady_clock::time_point now)
+    {
+        if (m_frame_stats)
+            m_frame_stats->flipped(now);
+
+        if (m_latency)
+            m_latency->presented(start, now);
+
+        if (m_hud->visible() && !m_frame_hud_only)
+            m_hud->frame(start, now);
+
+        if (m_profiler.running("first_frame"))
+        {
+            m_profiler.end("first_frame");
+            m_profiler.report();
+        }
+    }
+
+    void layout() override
+    {
+        Tracer::Scope trace("layout", "layout", "window");
+        egt::TopWindow::layout();
+    }
+
+    void handle(egt::Event& event) override
+    {
+        AllocStats::Scope alloc("event");
+        egt::TopWindow::handle(event);
+
+        input_handled(event);
+    }
+
+    /**
+     * Account the reaction to an input event, for the latency tracker.
+     */
+    void input_handled(const egt::Event& event)
+    {
+        InputKind kind;
+        if (m_latency && input_kind(event.id(), kind))
+            m_latency->handled(kind, std::chrono::steady_clock::now());
+    }
+
+    FrameActivity frame_activity() const
+    {
+        if (m_pager->dragging())
+            return FrameActivity::drag;
+        if (m_pager->animating())
+            return FrameActivity::page_turn;
+        if (m_sequence.running())
+            return FrameActivity::marquee;
+        return FrameActivity::none;
+    }
+
+    /**
+     * Report the frame, latency, allocation statistics and the memory use on
+     * stderr on each SIGUSR1.
+     */
+    void wait_report_signal()
+    {
+        m_report_signal->async_wait([this](const asio::error_code & error, int)
+        {
+            if (error)
+                return;
+
+            if (m_frame_stats)
+                m_frame_stats->report(std::cerr);
+            if (m_latency)
+                m_latency->report(std::cerr);
+            if (AllocStats::enabled())
+                AllocStats::report(std::cerr);
+            if (m_options.memory_report)
+                memory_report(std::cerr);
+            wait_report_signal();
+        });
+    }
+
+    /**
+     * Write the memory held by each part of the launcher, against the RSS.
+     */
+    void memory_report(std::ostream& out)
+    {
+        using Storage = MemoryReport::Storage;
+
+        MemoryReport report;
+
+        uint64_t mapped_icons = 0;
+        for (const auto& widget : m_pager->items())
+        {
+            const auto& item = static_cast<const LauncherItem&>(*widget);
+            report.add("items", item.memory_bytes());
+
+            auto* surface = item.image().surface().get();
+            const auto storage = (surface && m_icon_cache.maps(surface)) ? Storage::mapped : Storage::heap;
+            const auto bytes = report.surface("icons", surface, storage, item.text());
+            if (storage == Storage::mapped)
+                mapped_icons += bytes;
+        }
+        report.surface("icons", m_placeholder.get());
+
+        // icons shown from the cache file are accounted above
+        const auto mapped = m_icon_cache.mapped_bytes();
+        if (mapped)
+            report.add("icon_cache", mapped > mapped_icons ? mapped - mapped_icons : 0, 1, Storage::mapped);
+
+        if (auto background = m_background.lock())
+        {
+            if (m_snapshot_shown)
+                report.surface("background", background.get(), Storage::mapped, "snapshot");
+            else
+                report.surface("background", background.get(), Storage::heap, m_layout.background);
+        }
+        report.surface("logos", m_mchp_logo->image().surface().get(), Storage::heap, "microchip");
+        report.surface("logos", m_mgs_logo->image().surface().get(), Storage::heap, "mgs");
+
+        m_pager->memory(report);
+
+        // both layouts are static, whichever is in use
+        for (const auto* layout : {&landscape_layout, &portrait_layout})
+        {
+            for (const auto* props : {&layout->mgs_logo, &layout->mchp_logo, &layout->pager,
+                                      &layout->grid, &layout->item, &layout->indicator, &layout->lines})
+                report.add("properties", properties_bytes(*props));
+        }
+
+        report.add("manifests", m_manifests.memory_bytes(), source_count());
+
+        uint64_t entry_bytes = (m_entries.capacity() - m_entries.size()) * sizeof(ManifestEntry);
+        for (const auto& entry : m_entries)
+            entry_bytes += memory_bytes(entry);
+        report.add("entries", entry_bytes, m_entries.size());
+
+        uint64_t tagline_bytes = m_lines.capacity() * sizeof(std::string);
+        for (const auto& line : m_lines)
+            tagline_bytes += MemoryReport::heap_bytes(line);
+        report.add("taglines", tagline_bytes, m_lines.size());
+
+        report.write(out);
+    }
+
+    /**
+     * Current metrics, in the Prometheus text format.
+     */
+    std::string metrics() const
+    {
+        auto seconds = [](std::chrono::steady_clock::duration d)
+        {
+            return std::chrono::duration<double>(d).count();
+        };
+
+        MetricsPage page;
+        page.family("egt_launcher_entries", "gauge", "Launcher items.");
+        page.sample("egt_launcher_entries", item_count());
+        page.family("egt_launcher_manifests", "gauge", "Manifest files loaded.");
+        page.sample("egt_launcher_manifests", source_count());
+        page.family("egt_launcher_pages", "gauge", "Pages of items.");
+        page.sample("egt_launcher_pages", m_pager->page_count());
+
+        page.family("egt_launcher_startup_phase_seconds", "gauge",
+                    "Time spent in each startup phase.");
+        for (const auto* phase : m_profiler.phases())
+        {
+            page.sample("egt_launcher_startup_phase_seconds", seconds(m_profiler.total(phase)),
+                        MetricsPage::label("phase", phase));
+        }
+
+        if (m_frame_stats)
+        {
+            static const std::vector<uint64_t> bounds =
+            {
+                2000, 4000, 8000, 16667, 33333, 50000, 100000, 250000
+            };
+            static const std::array<FrameActivity, 3> activities =
+            {
+                FrameActivity::page_turn, FrameActivity::drag, FrameActivity::marquee
+            };
+
+            page.family("egt_launcher_frame_render_seconds", "histogram",
+                        "Render time of the frames drawn while animating.");
+            for (auto activity : activities)
+            {
+                page.histogram("egt_launcher_frame_render_seconds", m_frame_stats->render(activity),
+                               bounds, MetricsPage::label("activity", frame_activity_name(activity)));
+            }
+            page.family("egt_launcher_frame_flip_seconds", "histogram",
+                        "Time from the end of rendering until a frame is on screen.");
+            for (auto activity : activities)
+            {
+                page.histogram("egt_launcher_frame_flip_seconds", m_frame_stats->flip(activity),
+                               bounds, MetricsPage::label("activity", frame_activity_name(activity)));
+            }
+            page.family("egt_launcher_frames_dropped_total", "counter",
+                        "Frames missed while animating.");
+            for (auto activity : activities)
+            {
+                page.sample("egt_launcher_frames_dropped_total", m_frame_stats->dropped(activity),
+                            MetricsPage::label("activity", frame_activity_name(activity)));
             }
         }
-        catch (std::system_error& e)
+
+        page.family("egt_launcher_launches_total", "counter", "Applications launched.");
+        for (const auto& [exe, count] : m_launch_counts)
+            page.sample("egt_launcher_launches_total", count, MetricsPage::label("exec", exe));
+
+        if (!m_supervisor.records().empty())
+        {
+            page.family("egt_launcher_exits_total", "counter", "Resident applications exited.");
+            for (const auto& [exe, record] : m_supervisor.records())
+                page.sample("egt_launcher_exits_total", record.exits, MetricsPage::label("exec", exe));
+            page.family("egt_launcher_failures_total", "counter",
+                        "Resident applications exited on a signal or a non-zero status.");
+            for (const auto& [exe, record] : m_supervisor.records())
+                page.sample("egt_launcher_failures_total", record.failures, MetricsPage::label("exec", exe));
+            page.family("egt_launcher_restarts_total", "counter", "Failed applications restarted.");
+            for (const auto& [exe, record] : m_supervisor.records())
+                page.sample("egt_launcher_restarts_total", record.restarts, MetricsPage::label("exec", exe));
+            page.family("egt_launcher_crash_loops_total", "counter",
+                        "Restarts given up on repeated failures.");
+            for (const auto& [exe, record] : m_supervisor.records())
+                page.sample("egt_launcher_crash_loops_total", record.given_up, MetricsPage::label("exec", exe));
+        }
+
+        if (m_launch_history)
+        {
+            page.family("egt_launcher_launch_seconds", "summary",
+                        "Duration of the launch stages, over the recent launches.");
+            for (const auto& [exe, stages] : m_launch_history->summary())
+            {
+                for (size_t stage = 0; stage < LaunchHistory::STAGE_COUNT; ++stage)
+                {
+                    const auto& p = stages[stage];
+                    if (!p.count)
+                        continue;
+
+                    const auto labels = MetricsPage::label("exec", exe) + "," +
+                                        MetricsPage::label("stage", LaunchHistory::STAGES[stage]);
+                    page.sample("egt_launcher_launch_seconds", p.p50 / 1e6,
+                                labels + "," + MetricsPage::label("quantile", "0.5"));
+                    page.sample("egt_launcher_launch_seconds", p.p95 / 1e6,
+                                labels + "," + MetricsPage::label("quantile", "0.95"));
+                    page.sample("egt_launcher_launch_seconds_sum", p.sum / 1e6, labels);
+                    page.sample("egt_launcher_launch_seconds_count", p.count, labels);
+                }
+            }
+        }
+
+        page.family("egt_launcher_icon_cache_hits_total", "counter", "Icons found in the icon cache.");
+        page.sample("egt_launcher_icon_cache_hits_total", m_icon_cache.hits());
+        page.family("egt_launcher_icon_cache_misses_total", "counter", "Icons decoded.");
+        page.sample("egt_launcher_icon_cache_misses_total", m_icon_cache.misses());
+        page.family("egt_launcher_manifest_cache_hits_total", "counter",
+                    "Manifests found in the manifest cache.");
+        page.sample("egt_launcher_manifest_cache_hits_total", m_manifests.hits());
+        page.family("egt_launcher_manifest_cache_misses_total", "counter", "Manifests parsed.");
+        page.sample("egt_launcher_manifest_cache_misses_total", m_manifests.misses());
+
+        if (m_options.speculate || m_options.readahead)
         {
-            std::cerr << "exception: " << e.what() << std::endl;
+            page.family("egt_launcher_prefetch_files_total", "counter",
+                        "Files of applications read ahead.");
+            page.sample("egt_launcher_prefetch_files_total", m_prefetcher.files());
+            page.family("egt_launcher_prefetch_bytes_total", "counter",
+                        "Bytes of applications asked to be read ahead.");
+            page.sample("egt_launcher_prefetch_bytes_total", m_prefetcher.bytes());
+            page.family("egt_launcher_prefetch_cached_bytes_total", "counter",
+                        "Bytes of applications found already cached.");
+            page.sample("egt_launcher_prefetch_cached_bytes_total", m_prefetcher.cached_bytes());
         }
 
-        // give some determinism to the order of results
-        std::sort(files.begin(), files.end());
+        struct rusage usage {};
+        ::getrusage(RUSAGE_SELF, &usage);
+        page.family("egt_launcher_resident_memory_bytes", "gauge", "Resident set size.");
+        page.sample("egt_launcher_resident_memory_bytes", resident_memory());
+        page.family("egt_launcher_peak_resident_memory_bytes", "gauge", "Peak resident set size.");
+        page.sample("egt_launcher_peak_resident_memory_bytes", usage.ru_maxrss * 1024.);
+        page.family("egt_launcher_icon_surface_bytes", "gauge", "Pixel memory of the icon surfaces.");
+        page.sample("egt_launcher_icon_surface_bytes", icon_surface_bytes());
 
-        return files;
+        return page.text();
+    }
+
+    /**
+     * Show or hide the performance overlay.
+     */
+    void toggle_hud()
+    {
+        m_hud->toggle();
+    }
+
+    void prev_page()
+    {
+        m_pager->prev_page();
     }
 
-    void load_entry(rapidxml::xml_node<>* node)
+    void next_page()
     {
-        if (!node->first_node("title"))
+        m_pager->next_page();
+    }
+
+    void on_page_added()
+    {
+        const auto s = m_indicator_sizer->height();
+
+        auto radio = std::make_shared<egt::RadioBox>();
+        radio->disable();
+        radio->show_label(false);
+        radio->autoresize(false);
+        radio->resize({s, s});
+        m_indicator_group.add(radio);
+        m_indicator_sizer->add(radio);
+    }
+
+    void on_page_removed()
+    {
+        auto radio = m_indicator_sizer->child_at(m_indicator_sizer->count_children() - 1);
+        m_indicator_group.remove(static_cast<egt::RadioBox*>(radio.get()));
+        m_indicator_sizer->remove(radio.get());
+    }
+
+    void on_page_changed(size_t page_index)
+    {
+        m_icons.focus(page_index);
+        schedule_readahead();
+
+        if (page_index >= m_indicator_sizer->count_children())
             return;
 
-        const std::string name = node->first_node("title")->value();
+        auto& radio = *static_cast<egt::RadioBox*>(m_indicator_sizer->child_at(page_index).get());
+        radio.checked(true);
+    }
+
+    /**
+     * Run an application, argv being its command split into words,
+     * exit_keys the keys ending it and restart what to do when it fails.
+     */
+    void launch(const std::string& exe, const std::vector<std::string>& argv,
+                const KeyCodes& exit_keys, RestartPolicy restart)
+    {
+        Tracer::Scope trace("launch", "launch", exe);
+
+        if (m_options.resident && m_child.running())
+            return;
+
+        // a launch from the launcher replaces a restart waiting for its backoff
+        m_restart_timer.cancel();
+        // the prefetch goes on, the child forked ahead is taken if it matches
+        m_speculation_timer.cancel();
+        m_prefork_timer.cancel();
+        m_readahead_timer.cancel();
+        m_prefetcher.cancel_idle();
 
-        std::string description;
-        if (node->first_node("description"))
-            description = node->first_node("description")->value();
+        m_launch = {};
+        m_launch.click = LaunchTiming::Clock::now();
+        m_launch_exe = exe;
+        ++m_launch_counts[exe];
 
-        std::string image;
-        auto link = node->first_node("link");
-        if (link)
+        m_exit_keys = exit_keys;
+
+        if (m_options.resident)
         {
-            auto href = link->first_attribute("href");
-            if (href)
-                image = href->value();
+            m_resident = {exe, argv, exit_keys, restart};
+            suspend();
+            launch_resident(false);
+            return;
         }
 
-        if (!node->first_node("arg"))
+        egt::Application::instance().event().quit();
+
+#ifdef HAVE_EGT_DETAIL_SCREEN_KMSSCREEN_H
+        // explicitly close KMS
+        if (egt::detail::KMSScreen::instance())
+            egt::detail::KMSScreen::instance()->close();
+#endif
+
+        save_page_index();
+
+        if (m_options.direct_launch && launch_direct(argv))
             return;
 
-        std::string cmd = node->first_node("arg")->value();
+        const std::string cmd = DATADIR "/egt/launcher/launch.sh " + exe + " &";
+        drop_prefork();
+        if (m_ready)
+            m_ready->open();
+
+        // launch.sh starts the launcher again once the application exited
+        std::string args;
+        for (const auto& arg : m_options.args)
+            args += shell_quote(arg) + " ";
+        auto env = child_environment(exit_keys);
+        env.set(LAUNCHER_ARGS_ENV, args);
+
+        m_launch.spawn = LaunchTiming::Clock::now();
+        exec((env.assignments() + cmd).c_str());
+        m_launch.spawned = LaunchTiming::Clock::now();
+        if (m_ready)
+            m_ready->close_write();
+    }
+
+    /**
+     * Run an application without a shell or launch.sh, which are left to
+     * the exit key and the relaunch.
+     *
+     * Returns false if argv cannot be run.
+     */
+    bool launch_direct(const std::vector<std::string>& argv)
+    {
+        if (argv.empty())
+            return false;
 
-        const egt::Font::Size font_size = scale(11.f, 20.f);
-        const egt::DefaultDim image_size = scale(96.f, 96.f);
+        m_launch.spawn = LaunchTiming::Clock::now();
+        m_detached = spawn_direct(argv);
+        m_launch.spawned = LaunchTiming::Clock::now();
+        if (m_ready)
+            m_ready->close_write();
 
-        auto props = m_layout.item;
-        add_prop(props, "text", name);
-        add_prop(props, "image", "file:" + image,
+        if (m_detached < 0)
+            return false;
+
+        // argv is executed by the time the spawn returns
+        m_launch.exec = m_launch.spawned;
+        return true;
+    }
+
+    /**
+     * Application launched directly, to be waited for by relaunch_after()
+     * once the event loop returned, -1 if none.
+     */
+    pid_t detached() const
+    {
+        return m_detached;
+    }
+
+    /**
+     * Environment of relaunch_after(), for the detached application.
+     */
+    ChildEnvironment detached_environment() const
+    {
+        ChildEnvironment env;
+        if (!m_exit_keys.empty())
+            env.set(EXIT_KEYS_ENV, format_key_codes(m_exit_keys));
+        return env;
+    }
+
+    /**
+     * Read ahead the applications of the current page once the launcher is
+     * left idle for a while.
+     */
+    void schedule_readahead()
+    {
+        if (!m_options.readahead || m_suspended)
+            return;
+
+        m_readahead_timer.expires_after(READAHEAD_DELAY);
+        m_readahead_timer.async_wait([this](const asio::error_code & ec)
+        {
+            if (ec || m_suspended)
+                return;
+
+            std::vector<std::string> commands;
+            for (const auto& widget : m_pager->page_items(m_pager->page()))
+            {
+                const auto& argv = static_cast<const LauncherItem&>(*widget).argv();
+                if (!argv.empty())
+                    commands.push_back(argv[0]);
+            }
+
+            if (!commands.empty())
+                m_prefetcher.idle(commands, m_options.readahead);
+        });
+    }
+
+    /**
+     * Stop reading ahead on input, which is served first. The read ahead
+     * starts again once idle.
+     */
+    void input_started()
+    {
+        if (!m_options.readahead)
+            return;
+
+        m_prefetcher.cancel_idle();
+        schedule_readahead();
+    }
+
+    /**
+     * Get ready to launch the application of a pressed item, before the
+     * click confirms it: its files are read, and with --prefork its child
+     * is forked and left stopped once the press is not a drag.
+     *
+     * Dropped by cancel_speculation() on a drag, or after a while.
+     */
+    void speculate(const std::vector<std::string>& argv)
+    {
+        if (!m_options.speculate || argv.empty() || m_suspended || m_child.running())
+            return;
+
+        Tracer::Scope trace("speculate", "launch", argv[0]);
+
+        m_prefetcher.request(argv[0]);
+
+        // forking copies the page tables of the launcher, not worth it for
+        // a press which turns into a drag right away
+        if (m_options.prefork && m_options.direct_launch && m_prefork.argv() != argv)
+        {
+            m_prefork_timer.expires_after(PREFORK_DELAY);
+            m_prefork_timer.async_wait([this, argv](const asio::error_code & ec)
+            {
+                if (!ec)
+                    prefork(argv);
+            });
+        }
+
+        m_speculation_timer.expires_after(SPECULATION_TIMEOUT);
+        m_speculation_timer.async_wait([this](const asio::error_code & ec)
         {
-            { "keep_image_ratio", "false" },
+            if (!ec)
+                cancel_speculation();
         });
-        add_prop(props, "description", description);
-        add_prop(props, "exec", cmd);
+    }
+
+    /**
+     * Drop what speculate() started, the press not being a launch.
+     */
+    void cancel_speculation()
+    {
+        m_speculation_timer.cancel();
+        m_prefork_timer.cancel();
+        m_prefetcher.cancel();
+        drop_prefork();
+    }
+
+    /**
+     * Wait for the application launched before the event loop returned to
+     * be executed, and record the timing of the launch.
+     *
+     * Only a resident launcher times the application until it is ready.
+     */
+    void finish_launch()
+    {
+        if (!m_ready || m_options.resident || m_launch_exe.empty())
+            return;
+
+        // a direct launch already knows, launch.sh reports it right away
+        m_ready->wait_exec(m_launch, std::chrono::seconds(1));
+        record_launch();
+    }
+
+    void record_launch()
+    {
+        m_launch_history->add(m_launch_exe, m_launch);
+        m_launch_history->save();
+        if (m_options.verbose)
+            m_launch_history->report(std::cerr);
+        m_launch_exe.clear();
+    }
+
+    /**
+     * Run the application of m_resident while keeping the launcher alive,
+     * the display being already suspended.
+     *
+     * The display is handed over to the child, and taken back to repaint
+     * the existing widget tree once it exits, unless the supervisor
+     * restarts it. restart tells the supervisor whether this is a restart.
+     */
+    void launch_resident(bool restart)
+    {
+        const auto& exe = m_resident.exe;
+        const auto& argv = m_resident.argv;
+
+        auto exited = [this](int status)
+        {
+            m_exit_key.stop();
+            // the application exited without reporting it was ready
+            if (m_ready)
+                m_ready->close();
+            if (!m_launch_exe.empty())
+                record_launch();
+            supervise(status);
+        };
+
+        const bool direct = m_options.direct_launch && !argv.empty();
+        const std::string cmd = DATADIR "/egt/launcher/launch.sh --resident " + exe;
+        bool spawned = false;
+        m_launch.spawn = LaunchTiming::Clock::now();
+        if (direct)
+        {
+            const auto pid = spawn_direct(argv);
+            spawned = pid > 0 && m_child.watch(pid, exited);
+        }
+        else
+        {
+            drop_prefork();
+            if (m_ready)
+                m_ready->open();
+            spawned = m_child.spawn(cmd, exited, m_ready ? m_ready->write_fd() : -1,
+                                    child_environment(m_resident.exit_keys));
+        }
+        m_launch.spawned = LaunchTiming::Clock::now();
+
+        if (spawned)
+        {
+            m_terminating = false;
+            m_supervisor.started(exe, restart);
+        }
+
+        if (direct && spawned)
+        {
+            m_launch.exec = m_launch.spawned;
+            m_exit_key.start(m_resident.exit_keys, [this]()
+            {
+                m_terminating = true;
+                m_child.terminate(EXIT_GRACE);
+            });
+        }
+
+        if (!m_ready)
+        {
+            if (!spawned)
+                resume();
+            return;
+        }
+
+        m_ready->close_write();
+        if (!spawned)
+        {
+            m_ready->close();
+            m_launch_exe.clear();
+            resume();
+            return;
+        }
+
+        m_ready->async_wait(m_launch, [this]() { record_launch(); });
+    }
+
+    /**
+     * Show the launcher again after the resident application exited with
+     * status, or restart it as its policy says.
+     */
+    void supervise(int status)
+    {
+        const auto& exe = m_resident.exe;
+        const auto decision = m_supervisor.exited(exe, status, m_terminating, m_resident.restart);
+
+        if (m_options.verbose)
+        {
+            const auto& record = m_supervisor.records().at(exe);
+            std::cerr << exe << " exited with " << Supervisor::status_name(status) << " after "
+                      << std::chrono::duration_cast<std::chrono::milliseconds>(record.runtime).count()
+                      << " ms" << std::endl;
+        }
+
+        switch (decision.action)
+        {
+        case Supervisor::Action::restart:
+        {
+            auto restart = [this]()
+            {
+                m_launch = {};
+                m_launch.click = LaunchTiming::Clock::now();
+                m_launch_exe = m_resident.exe;
+                launch_resident(true);
+            };
+
+            // the display is kept by the child to come, unless there is a wait
+            if (!decision.delay.count())
+            {
+                restart();
+                return;
+            }
+
+            resume();
+            m_restart_timer.expires_after(decision.delay);
+            m_restart_timer.async_wait([this, restart](const asio::error_code & ec)
+            {
+                if (ec)
+                    return;
+
+                suspend();
+                restart();
+            });
+            return;
+        }
+        case Supervisor::Action::give_up:
+            std::cerr << "not restarting " << exe << ", it keeps failing" << std::endl;
+            break;
+        default:
+            break;
+        }
+
+        resume();
+    }
+
+    /**
+     * Run argv without a shell, resuming the child forked ahead for it, if
+     * any. Returns the pid, or -1 if argv cannot be run.
+     */
+    pid_t spawn_direct(const std::vector<std::string>& argv)
+    {
+        if (m_prefork.pending() && m_prefork.argv() == argv)
+        {
+            // the ready pipe was opened before the fork
+            const auto pid = m_prefork.commit();
+            if (pid > 0)
+                return pid;
+        }
+
+        drop_prefork();
+        if (m_ready)
+            m_ready->open();
+        return spawn_process(argv, m_ready ? m_ready->write_fd() : -1, child_environment());
+    }
+
+    /**
+     * Environment of the application about to be spawned, the launcher
+     * keeping its own unchanged.
+     *
+     * exit_keys are for launch.sh and relaunch_after(), which end the
+     * application on them.
+     */
+    ChildEnvironment child_environment(const KeyCodes& exit_keys = {}) const
+    {
+        ChildEnvironment env;
+        if (m_ready)
+            m_ready->environment(env);
+        if (!exit_keys.empty())
+            env.set(EXIT_KEYS_ENV, format_key_codes(exit_keys));
+        return env;
+    }
+
+    /**
+     * Fork the child of argv ahead, stopped until spawn_direct() commits it.
+     */
+    void prefork(const std::vector<std::string>& argv)
+    {
+        if (m_suspended || m_child.running())
+            return;
+
+        Tracer::Scope trace("prefork", "launch", argv[0]);
+
+        // the ready pipe must be inherited by the child forked now
+        if (m_ready)
+            m_ready->open();
+        if (!m_prefork.fork(argv, m_ready ? m_ready->write_fd() : -1, child_environment()) &&
+            m_ready)
+            m_ready->close();
+    }
+
+    /**
+     * Kill the child forked ahead, and close the ready pipe it inherited.
+     */
+    void drop_prefork()
+    {
+        if (!m_prefork.pending())
+            return;
+
+        m_prefork.cancel();
+        if (m_ready)
+            m_ready->close();
+    }
+
+    /**
+     * Stop drawing and release the display.
+     */
+    void suspend()
+    {
+        m_suspended = true;
+        m_sequence.stop();
+        // a hidden window is never drawn, so nothing is flipped without DRM master
+        hide();
+        m_display.release();
+    }
+
+    /**
+     * Take the display back and repaint.
+     */
+    void resume()
+    {
+        m_display.acquire();
+        show();
+        damage();
+        m_sequence.start();
+        m_suspended = false;
+        // the application may have pushed the page out of the cache
+        schedule_readahead();
+    }
+
+    bool suspended() const
+    {
+        return m_suspended;
+    }
+
+    std::vector<std::string> get_files(const std::string& dir)
+    {
+        Tracer::Scope trace("get_files", "load", dir);
+        Profiler::Scope phase(m_profiler, "scan");
+
+        ScanStats stats;
+        std::vector<std::string> dirs;
+        auto files = scan_files(dir, m_options.scan, m_options.jobs, stats,
+                                (m_watcher || m_options.snapshot) ? &dirs : nullptr);
+
+        for (auto& d : dirs)
+        {
+            if (m_watcher)
+                m_watcher->watch(d);
+
+            // adding or removing a manifest changes the stamp of its directory
+            FileStamp stamp;
+            if (m_options.snapshot && file_stamp(d, stamp))
+                m_scanned_dirs.emplace_back(d, stamp);
+        }
+
+        if (m_options.verbose)
+        {
+            std::cerr << "scanned " << dir << ": " << stats.scanned << " entries in " <<
+                      stats.dirs << " directories, " << stats.matched << " matched, " <<
+                      stats.elapsed.count() << " us" << std::endl;
+        }
+
+        return files;
+    }
+
+    /**
+     * Create the item of a manifest entry, its icon is decoded with the
+     * priority of the given page.
+     */
+    std::shared_ptr<LauncherItem> load_entry(const ManifestEntry& entry, size_t page)
+    {
+        Tracer::Scope trace("load_entry", "load", entry.title);
+
+        const egt::DefaultDim image_size = icon_size();
+
+        // PNG icons are decoded in the background, other formats by EGT
+        const bool async_icon = std::filesystem::path(entry.image).extension() == ".png";
+
+        auto props = m_layout.item;
+        add_prop(props, "text", entry.title);
+        if (!async_icon)
+        {
+            add_prop(props, "image", "file:" + entry.image,
+            {
+                { "keep_image_ratio", "false" },
+            });
+        }
+        add_prop(props, "description", entry.description);
+        add_prop(props, "exec", entry.arg);
+        add_item_style(props);
+        auto item = std::make_shared<LauncherItem>(props, *this);
+        item->icon(entry.image);
+        item->command(entry);
+
+        if (async_icon)
+            load_icon(item, page);
+        else
+            item->image().resize(egt::Size(image_size, image_size));
+
+        return item;
+    }
+
+    /**
+     * Properties shared by all the items.
+     */
+    void add_item_style(egt::Serializer::Properties& props) const
+    {
+        const egt::Font::Size font_size = scale(11.f, 20.f);
+
         add_prop(props, "align", "expand");
         add_prop(props, "text_align", "center_horizontal|bottom");
         add_prop(props, "image_align", "top");
@@ -685,53 +2154,332 @@ public:
             { "slant", "normal" },
             { "size", std::to_string(font_size) },
         });
-        auto item = std::make_shared<LauncherItem>(props, *this);
-        item->image().resize(egt::Size(image_size, image_size));
-        m_pager->add_item(item);
+    }
+
+    /**
+     * Show the PNG icon of an item, from the icon cache or decoded with the
+     * priority of the given page.
+     */
+    void load_icon(const std::shared_ptr<LauncherItem>& item, size_t page)
+    {
+        const egt::DefaultDim image_size = icon_size();
+        const auto image = item->icon();
+        const auto icon_path = egt::resolve_file_path(image);
+
+        auto icon = m_icon_cache.lookup(icon_path);
+        item->image(egt::Image(icon ? icon : placeholder(image_size)));
+        if (icon)
+            return;
+
+        std::weak_ptr<LauncherItem> weak = item;
+        m_icons.request(page, icon_path, image_size, image_size,
+                        [weak, image](const IconSurface & surface)
+        {
+            // a recycled item may show another entry by now
+            auto item = weak.lock();
+            if (item && surface && item->icon() == image)
+                item->image(egt::Image(surface));
+        });
+    }
+
+    /**
+     * Blank item of a virtualized pager.
+     */
+    std::shared_ptr<LauncherItem> create_item()
+    {
+        auto props = m_layout.item;
+        add_item_style(props);
+        return std::make_shared<LauncherItem>(props, *this);
+    }
+
+    /**
+     * Show an entry in an item recycled by a virtualized pager.
+     */
+    void bind_item(const std::shared_ptr<LauncherItem>& item, size_t index)
+    {
+        const auto& entry = m_entries[index];
+        item->entry(entry);
+
+        if (item->icon() == entry.image)
+            return;
+        item->icon(entry.image);
+
+        if (std::filesystem::path(entry.image).extension() == ".png")
+            load_icon(item, index / m_pager->items_per_page());
+        else
+        {
+            const egt::DefaultDim image_size = icon_size();
+            item->image(egt::Image("file:" + entry.image));
+            item->keep_image_ratio(false);
+            item->image().resize(egt::Size(image_size, image_size));
+        }
+    }
+
+    /**
+     * Transparent image shown until the icon of an item is decoded.
+     */
+    IconSurface placeholder(egt::DefaultDim size)
+    {
+        if (!m_placeholder || cairo_image_surface_get_width(m_placeholder.get()) != size)
+            m_placeholder = make_icon_surface(cairo_image_surface_create(CAIRO_FORMAT_ARGB32, size, size));
+
+        return m_placeholder;
     }
 
     int load(const std::string& dir)
     {
         std::vector<std::string> files = get_files(dir);
+        std::vector<std::shared_ptr<egt::Widget>> items;
 
-        for (auto& file : files)
+        std::vector<const Manifest*> manifests;
         {
-            rapidxml::file<> xml_file(file.c_str());
-            rapidxml::xml_document<> doc;
-            doc.parse<0>(xml_file.data());
+            Profiler::Scope phase(m_profiler, "parse");
+            manifests = m_manifests.get(files, m_options.jobs);
+        }
+
+        Profiler::Scope phase(m_profiler, "items");
+
+        // parsing may run on worker threads, but widgets are only created here
+        for (const auto* manifest : manifests)
+        {
+            Source source{manifest->path, manifest->stamp, {}};
+
+            if (!manifest->entries.empty())
+                add_search_path(manifest->dir);
 
-            auto feed = doc.first_node("feed");
-            if (feed)
+            if (m_pager->virtualized())
+                m_entries.insert(m_entries.end(), manifest->entries.begin(), manifest->entries.end());
+            else
             {
-                for (auto screen = feed->first_node("screen"); screen; screen = screen->next_sibling("screen"))
+                for (auto& entry : manifest->entries)
                 {
-                    for (auto entry = screen->first_node("entry"); entry; entry = entry->next_sibling("entry"))
-                    {
-                        egt::add_search_path(egt::detail::extract_dirname(file));
-                        load_entry(entry);
-                    }
+                    const auto index = m_pager->item_count() + items.size();
+                    auto item = load_entry(entry, index / m_pager->items_per_page());
+                    items.push_back(item);
+                    source.items.push_back(item);
                 }
             }
-            else
+
+            m_sources.push_back(std::move(source));
+        }
+
+        if (m_pager->virtualized())
+            m_pager->count(m_entries.size());
+        else
+            m_pager->add_items(items);
+
+        return 0;
+    }
+
+    /**
+     * Load all the directories again, after a change on disk.
+     *
+     * Items of unchanged manifests are kept as they are, so only the pages
+     * from the first added, changed or removed item on are reflowed.
+     */
+    void reload()
+    {
+        // manifests removed since the last scan are dropped from the cache
+        m_manifests.rescan();
+
+        if (m_pager->virtualized())
+        {
+            // no widget per item, so there is nothing to keep
+            m_sources.clear();
+            m_scanned_dirs.clear();
+            m_entries.clear();
+            for (auto& dir : m_options.dirs)
+            {
+                for (const auto* manifest : m_manifests.get(get_files(dir), m_options.jobs))
+                {
+                    if (!manifest->entries.empty())
+                        add_search_path(manifest->dir);
+
+                    m_entries.insert(m_entries.end(), manifest->entries.begin(), manifest->entries.end());
+                    m_sources.push_back({manifest->path, manifest->stamp, {}});
+                }
+            }
+            m_pager->count(m_entries.size());
+            m_manifests.save();
+            return;
+        }
+
+        std::unordered_map<std::string, Source> previous;
+        for (auto& source : m_sources)
+        {
+            auto file = source.file;
+            previous.emplace(std::move(file), std::move(source));
+        }
+        m_sources.clear();
+        m_scanned_dirs.clear();
+
+        std::vector<std::shared_ptr<egt::Widget>> items;
+        const auto per_page = m_pager->items_per_page();
+
+        for (auto& dir : m_options.dirs)
+        {
+            auto files = get_files(dir);
+            for (const auto* manifest : m_manifests.get(files, m_options.jobs))
             {
-                for (auto entry = doc.first_node("entry"); entry; entry = entry->next_sibling("entry"))
+                auto p = previous.find(manifest->path);
+                if (p != previous.end() && p->second.stamp == manifest->stamp)
                 {
-                    egt::add_search_path(egt::detail::extract_dirname(file));
-                    load_entry(entry);
+                    items.insert(items.end(), p->second.items.begin(), p->second.items.end());
+                    m_sources.push_back(std::move(p->second));
+                    previous.erase(p);
+                    continue;
                 }
+
+                Source source{manifest->path, manifest->stamp, {}};
+
+                if (!manifest->entries.empty())
+                    add_search_path(manifest->dir);
+
+                for (auto& entry : manifest->entries)
+                {
+                    auto item = load_entry(entry, items.size() / per_page);
+                    items.push_back(item);
+                    source.items.push_back(item);
+                }
+
+                m_sources.push_back(std::move(source));
             }
         }
 
-        return 0;
+        m_pager->update(std::move(items));
+        m_manifests.save();
+    }
+
+    size_t source_count() const
+    {
+        return m_sources.size();
+    }
+
+    size_t item_count() const
+    {
+        return m_pager->item_count();
+    }
+
+    /**
+     * Add the directory of a manifest to the EGT search paths, once.
+     */
+    void add_search_path(const std::string& dir)
+    {
+        if (m_search_paths.insert(dir).second)
+            egt::add_search_path(dir);
+    }
+
+    /**
+     * Write the manifest cache, once all directories have been loaded.
+     */
+    void save_cache()
+    {
+        m_manifests.save();
     }
 
     void load_page_index()
     {
-        size_t page = 0;
-        std::ifstream in(PAGE_FILENAME);
-        if (in.is_open())
-            in >> page;
-        m_pager->page(page);
+        m_pager->page(read_page_index());
+    }
+
+    /**
+     * Replace the snapshot shown while starting with the live widget tree.
+     */
+    void drop_snapshot()
+    {
+        if (!m_snapshot_shown)
+            return;
+
+        Profiler::Scope phase(m_profiler, "background");
+
+        // releases the mapping of the snapshot
+        show_background(egt::Image(std::string("file:") + m_layout.background));
+        m_snapshot_shown = false;
+    }
+
+    /**
+     * Set the background of the window, and keep track of its surface for
+     * the memory report.
+     */
+    void show_background(const egt::Image& image)
+    {
+        m_background = image.surface();
+        background(image);
+    }
+
+    /**
+     * Save the frame once it stopped changing for a while, off the launch
+     * path.
+     */
+    void schedule_snapshot()
+    {
+        if (!m_options.snapshot || m_snapshot_shown || m_snapshot_scheduled)
+            return;
+
+        m_snapshot_scheduled = true;
+        m_snapshot_timer.expires_after(SNAPSHOT_DELAY);
+        m_snapshot_timer.async_wait([this](const asio::error_code & ec)
+        {
+            m_snapshot_scheduled = false;
+            // resume() repaints, which schedules it again
+            if (ec || m_suspended)
+                return;
+
+            const auto activity = frame_activity();
+            if (activity == FrameActivity::drag || activity == FrameActivity::page_turn)
+                schedule_snapshot();
+            else
+                save_snapshot();
+        });
+    }
+
+    /**
+     * Save the frame now if it changed since the last snapshot, once the
+     * application is started.
+     */
+    void flush_snapshot()
+    {
+        if (!m_snapshot_scheduled)
+            return;
+
+        m_snapshot_timer.cancel();
+        m_snapshot_scheduled = false;
+        save_snapshot();
+    }
+
+    /**
+     * The damaged rectangle is within the band of the scrolling taglines,
+     * which are not worth a new snapshot.
+     */
+    bool tagline_only(const egt::Rect& rect) const
+    {
+        if (!m_tagline)
+            return false;
+
+        const auto band = m_tagline->box();
+        return rect.y() >= band.y() && rect.y() + rect.height() <= band.y() + band.height();
+    }
+
+    /**
+     * Save the current frame, to be shown by the next start.
+     */
+    void save_snapshot()
+    {
+        if (!m_options.snapshot || m_snapshot_shown)
+            return;
+
+        Tracer::Scope trace("save_snapshot", "draw");
+
+        auto frame = make_icon_surface(cairo_image_surface_create(CAIRO_FORMAT_ARGB32,
+                                       width(), height()));
+        egt::Painter painter(std::shared_ptr<cairo_t>(cairo_create(frame.get()), cairo_destroy));
+        paint(painter);
+
+        auto sources = m_scanned_dirs;
+        for (auto& source : m_sources)
+            sources.emplace_back(source.file, source.stamp);
+
+        m_snapshot.save(frame, m_pager->page(), sources);
     }
 
     void save_page_index() const
@@ -767,6 +2515,7 @@ public:
             });
             auto vsizer = std::make_shared<egt::Frame>(props);
             add(vsizer);
+            m_tagline = vsizer;
 
             auto label = std::make_shared<egt::Label>();
             vsizer->add(egt::expand(label));
@@ -780,6 +2529,8 @@ public:
                       egt::easing_exponential_easeout);
             in->on_change([vsizer](int value)
             {
+                AllocStats::Scope alloc("marquee");
+                Tracer::instance().counter("tagline_position", "animation", value);
                 vsizer->x(value);
             });
 
@@ -791,6 +2542,8 @@ public:
             out->reverse(true);
             out->on_change([this, vsizer, out, label](int value)
             {
+                AllocStats::Scope alloc("marquee");
+                Tracer::instance().counter("tagline_position", "animation", value);
                 vsizer->x(value);
 
                 static size_t index = 0;
@@ -814,6 +2567,14 @@ public:
 
 protected:
 
+    /// Items created from one manifest file.
+    struct Source
+    {
+        std::string file;
+        FileStamp stamp;
+        std::vector<std::shared_ptr<LauncherItem>> items;
+    };
+
     float scale(float landscape_value, float portrait_value) const
     {
         if (m_layout.landscape)
@@ -822,14 +2583,91 @@ protected:
         return (portrait_value * height()) / 1280.f;
     }
 
+    /**
+     * Size of the icon of a LauncherItem.
+     */
+    egt::DefaultDim icon_size() const
+    {
+        return scale(96.f, 96.f);
+    }
+
 private:
 
     const Layout& m_layout;
+    const Options& m_options;
+    Profiler& m_profiler;
+    bool m_frame_pending{false};
+    /// Only the performance overlay is drawn in the pending frame.
+    bool m_frame_hud_only{false};
+    std::shared_ptr<PerfHud> m_hud;
+    std::unique_ptr<FrameStats> m_frame_stats;
+    std::unique_ptr<LatencyTracker> m_latency;
+    std::unique_ptr<asio::signal_set> m_report_signal;
+    std::unique_ptr<ReadyPipe> m_ready;
+    std::unique_ptr<LaunchHistory> m_launch_history;
+    /// Timing of the last launch, and its command while not recorded.
+    LaunchTiming m_launch;
+    std::string m_launch_exe;
+    /// Launches of each command since startup.
+    std::map<std::string, uint64_t> m_launch_counts;
+    std::unique_ptr<MetricsServer> m_metrics;
     egt::ButtonGroup m_indicator_group;
     Pager* m_pager{nullptr};
     egt::BoxSizer* m_indicator_sizer{nullptr};
+    egt::ImageLabel* m_mchp_logo{nullptr};
+    egt::ImageLabel* m_mgs_logo{nullptr};
+    /// Not kept alive, the snapshot must be unmapped once dropped.
+    std::weak_ptr<cairo_surface_t> m_background;
     std::vector<std::string> m_lines;
     egt::AnimationSequence m_sequence{true};
+    ManifestCache m_manifests;
+    IconCache m_icon_cache;
+    IconLoader m_icons{egt::Application::instance().event().io(), &m_icon_cache};
+    IconSurface m_placeholder;
+    std::vector<Source> m_sources;
+    /// Directories of the manifests added to the EGT search paths.
+    std::unordered_set<std::string> m_search_paths;
+    /// Entries of all the sources, in page order, when the pager is virtualized.
+    std::vector<ManifestEntry> m_entries;
+    /// Directories scanned for manifests, the snapshot depends on them.
+    std::vector<Snapshot::Source> m_scanned_dirs;
+    Snapshot m_snapshot;
+    bool m_snapshot_shown{false};
+    /// Saves the snapshot once the frame stopped changing.
+    asio::steady_timer m_snapshot_timer{egt::Application::instance().event().io()};
+    bool m_snapshot_scheduled{false};
+    /// Scrolling taglines, their frames do not change the snapshot.
+    std::shared_ptr<egt::Frame> m_tagline;
+    std::unique_ptr<Watcher> m_watcher;
+    ChildWatch m_child{egt::Application::instance().event().io()};
+    /// Application run by a resident launcher, restarted by the supervisor.
+    struct Resident
+    {
+        std::string exe;
+        std::vector<std::string> argv;
+        KeyCodes exit_keys;
+        RestartPolicy restart{RestartPolicy::home};
+    };
+    Resident m_resident;
+    Supervisor m_supervisor;
+    asio::steady_timer m_restart_timer{egt::Application::instance().event().io()};
+    /// The resident application is being ended with an exit key.
+    bool m_terminating{false};
+    Prefetcher m_prefetcher;
+    /// Starts the read ahead of the current page once idle.
+    asio::steady_timer m_readahead_timer{egt::Application::instance().event().io()};
+    Prefork m_prefork;
+    /// Drops a speculation which was not confirmed by a click in time.
+    asio::steady_timer m_speculation_timer{egt::Application::instance().event().io()};
+    /// Forks the pressed application once the press is not a drag.
+    asio::steady_timer m_prefork_timer{egt::Application::instance().event().io()};
+    ExitKey m_exit_key{egt::Application::instance().event().io()};
+    /// Application launched directly, waited for once the event loop returned.
+    pid_t m_detached{-1};
+    /// Exit keys of the last application launched.
+    KeyCodes m_exit_keys;
+    DisplayHandoff m_display;
+    bool m_suspended{false};
 };
 
 void LauncherItem::handle(egt::Event& event)
@@ -838,9 +2676,14 @@ void LauncherItem::handle(egt::Event& event)
 
     switch (event.id())
     {
+    case egt::EventId::raw_pointer_down:
+    {
+        m_window.speculate(m_argv);
+        break;
+    }
     case egt::EventId::pointer_click:
     {
-        m_window.launch(m_exec);
+        m_window.launch(m_exec, m_argv, m_exit_keys, m_restart);
         event.stop();
         break;
     }
@@ -849,13 +2692,125 @@ void LauncherItem::handle(egt::Event& event)
     }
 }
 
+/*
+ * Print the result of --benchmark, as a single line of key=value pairs.
+ */
+static void report_benchmark(const Profiler& profiler, const LauncherWindow& win,
+                             Profiler::Clock::time_point start)
+{
+    auto us = [](Profiler::Clock::duration d)
+    {
+        return std::chrono::duration_cast<std::chrono::microseconds>(d).count();
+    };
+
+    const auto load = profiler.total("scan") + profiler.total("parse") + profiler.total("items");
+    const auto rate = load.count() ? win.item_count() * 1000000. / us(load) : 0.;
+
+    struct rusage usage {};
+    ::getrusage(RUSAGE_SELF, &usage);
+
+    std::cout << "entries=" << win.item_count() <<
+              " manifests=" << win.source_count();
+    for (const auto* phase : {"application", "window", "scan", "parse", "items", "save_cache"})
+        std::cout << " " << phase << "_us=" << us(profiler.total(phase));
+    std::cout << " total_us=" << us(Profiler::Clock::now() - start) <<
+              " entries_per_s=" << static_cast<uint64_t>(rate) <<
+              " peak_rss_kb=" << usage.ru_maxrss << std::endl;
+}
+
+/*
+ * Replace the launcher with a process only waiting for the application
+ * launched directly, which starts the launcher again once it exits.
+ *
+ * Returns only on failure.
+ */
+static void detach(pid_t pid, int argc, char** argv, const ChildEnvironment& env)
+{
+    const auto wait = "--wait-pid=" + std::to_string(pid);
+    std::vector<char*> args{argv[0], const_cast<char*>(wait.c_str())};
+    args.insert(args.end(), argv + 1, argv + argc);
+    args.push_back(nullptr);
+
+    Tracer::instance().close();
+    // the display is already closed, and no input is read any longer
+    close_inherited_fds();
+    ::execve("/proc/self/exe", args.data(), env.envp());
+    std::cerr << "cannot wait for " << pid << ": " << std::strerror(errno) << std::endl;
+}
+
+/*
+ * Wait for an application launched directly, ending it on an exit key,
+ * then start the launcher again with the same options.
+ */
+static int relaunch_after(pid_t pid, int argc, char** argv)
+{
+    KeyCodes keys;
+    // NOLINTNEXTLINE(concurrency-mt-unsafe)
+    if (const char* list = std::getenv(EXIT_KEYS_ENV))
+        parse_key_codes(list, keys);
+    // NOLINTNEXTLINE(concurrency-mt-unsafe)
+    ::unsetenv(EXIT_KEYS_ENV);
+
+    watch_exit_keys(pid, keys, EXIT_GRACE);
+    ::waitpid(pid, nullptr, 0);
+
+    // detach() put the wait option first
+    std::vector<char*> args{argv[0]};
+    args.insert(args.end(), argv + 2, argv + argc);
+    args.push_back(nullptr);
+
+    ::execv("/proc/self/exe", args.data());
+    std::cerr << "cannot relaunch " << argv[0] << ": " << std::strerror(errno) << std::endl;
+    return EXIT_FAILURE;
+}
+
 int main(int argc, char** argv)
 {
+    const auto start = Profiler::Clock::now();
+    ReadyPipe::close_inherited();
+    const auto options = parse_options(argc, argv);
+
+    if (options.wait_pid > 0)
+        return relaunch_after(options.wait_pid, argc, argv);
+
+    // keys inherited through launch.sh are those of the previous application,
+    // dropped while no thread runs yet
+    // NOLINTNEXTLINE(concurrency-mt-unsafe)
+    ::unsetenv(EXIT_KEYS_ENV);
+
+    if (options.alloc_stats)
+        AllocStats::enable();
+
+    if (!options.trace.empty() || options.trace_marker)
+        Tracer::instance().open(options.trace, options.trace_marker);
+    Tracer::instance().thread_name("ui");
+
+    if (options.launch_history)
+    {
+        LaunchHistory history(cache_file(options.cache_dir, "launches"));
+        if (!history.open())
+        {
+            std::cerr << "no launch history" << std::endl;
+            return EXIT_FAILURE;
+        }
+        history.report(std::cout);
+        return EXIT_SUCCESS;
+    }
+    Profiler profiler(options.profile, start);
+    if (options.benchmark || !options.metrics.empty())
+        profiler.enable();
+
+    profiler.begin("application");
     egt::Application app(argc, argv);
+    profiler.end("application");
 
-    // ensure max brightness of LCD screen
-    egt::Application::instance().screen()->brightness(
-        egt::Application::instance().screen()->max_brightness());
+    {
+        Profiler::Scope phase(profiler, "brightness");
+
+        // ensure max brightness of LCD screen
+        egt::Application::instance().screen()->brightness(
+            egt::Application::instance().screen()->max_brightness());
+    }
 
     // select the application layout
     const auto screen_size = app.screen()->size();
@@ -865,42 +2820,85 @@ int main(int argc, char** argv)
     egt::add_search_path(DATADIR "/egt/launcher/");
     egt::add_search_path("images/");
 
-    LauncherWindow win(*layout);
+    profiler.begin("window");
+    LauncherWindow win(*layout, options, profiler);
+    profiler.end("window");
+
+    for (auto& dir : options.dirs)
+        win.load(dir);
 
-    // load some default directories if nothing is specified
-    if (argc <= 1)
     {
-        win.load(DATADIR "/egt/");
+        Profiler::Scope phase(profiler, "save_cache");
+        win.save_cache();
     }
-    else
+
+    if (options.benchmark)
     {
-        for (auto i = 1; i < argc; i++)
-            win.load(argv[i]);
+        report_benchmark(profiler, win, start);
+        if (options.memory_report)
+            win.memory_report(std::cerr);
+        return EXIT_SUCCESS;
     }
 
-    win.load_page_index();
+    {
+        Profiler::Scope phase(profiler, "page_index");
+        win.load_page_index();
+    }
 
     {
+        Profiler::Scope phase(profiler, "lines");
         std::ifstream in(egt::resolve_file_path("taglines.txt"), std::ios::binary);
         if (in.is_open())
             win.lines(in);
     }
 
-    SwipeDetect swipe([&win](const std::string & direction)
+    win.drop_snapshot();
+
+    SwipeDetect swipe([&win, landscape](SwipeDirection direction)
     {
-        if (direction == "right")
+        if (win.suspended())
+            return;
+
+        win.cancel_speculation();
+
+        if (direction == SwipeDirection::right)
             win.next_page();
-        else if (direction == "left")
+        else if (direction == SwipeDirection::left)
             win.prev_page();
+        // pages turn vertically in portrait, where only the option shows the overlay
+        else if (direction == SwipeDirection::down && landscape)
+            win.toggle_hud();
     });
 
     // feed global events to swipe detector
-    egt::Input::global_input().on_event([&swipe](egt::Event & event)
+    egt::Input::global_input().on_event([&swipe, &win](egt::Event & event)
     {
+        AllocStats::Scope alloc("swipe");
+        // a drag turns pages, it does not launch the pressed item
+        if (event.id() == egt::EventId::pointer_drag_start)
+        {
+            win.cancel_speculation();
+            return;
+        }
+        if (event.id() == egt::EventId::raw_pointer_down)
+            win.input_started();
         swipe.handle(event);
-    }, {egt::EventId::raw_pointer_down, egt::EventId::raw_pointer_up});
+        win.input_handled(event);
+    }, {egt::EventId::raw_pointer_down, egt::EventId::raw_pointer_up,
+        egt::EventId::pointer_drag_start
+       });
 
     win.show();
 
-    return app.run();
+    profiler.begin("first_frame");
+
+    const auto ret = app.run();
+    win.finish_launch();
+    // the application is started first, the frame left is saved after
+    win.flush_snapshot();
+    if (options.memory_report)
+        win.memory_report(std::cerr);
+    if (win.detached() > 0)
+        detach(win.detached(), argc, argv, win.detached_environment());
+    return ret;
 }
@@ -0,0 +1,377 @@
+/*
+ * Copyright (C) 2026 Microchip Technology Inc.  All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "cache.h"
+#include "launchtiming.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <iomanip>
+#include <iostream>
+#include <poll.h>
+#include <unistd.h>
+#include <vector>
+
+/// Environment variable holding the write end of the readiness pipe.
+static const char* const LAUNCH_READY_FD_ENV = "EGT_LAUNCHER_READY_FD";
+
+/// "EGLH"
+static const uint32_t HISTORY_MAGIC = 0x484c4745;
+static const uint32_t HISTORY_VERSION = 1;
+
+ReadyPipe::ReadyPipe(asio::io_context& io)
+    : m_read(io)
+{}
+
+ReadyPipe::~ReadyPipe()
+{
+    close();
+}
+
+bool ReadyPipe::open()
+{
+    close();
+
+    std::array<int, 2> fds{};
+    if (::pipe2(fds.data(), O_CLOEXEC) < 0)
+    {
+        std::cerr << "pipe2: " << std::strerror(errno) << std::endl;
+        return false;
+    }
+
+    ::fcntl(fds[0], F_SETFL, ::fcntl(fds[0], F_GETFL) | O_NONBLOCK);
+    // inherited by the shell running launch.sh, and by the application
+    ::fcntl(fds[1], F_SETFD, 0);
+
+    m_read.assign(fds[0]);
+    m_write = fds[1];
+    m_line.clear();
+    return true;
+}
+
+void ReadyPipe::environment(ChildEnvironment& env) const
+{
+    if (m_write >= 0)
+        env.set(LAUNCH_READY_FD_ENV, std::to_string(m_write));
+}
+
+void ReadyPipe::close_write()
+{
+    if (m_write < 0)
+        return;
+
+    ::close(m_write);
+    m_write = -1;
+}
+
+void ReadyPipe::close()
+{
+    close_write();
+
+    asio::error_code ec;
+    m_read.close(ec);
+
+    // nothing is called back from the destructor, the handler sees the abort
+    m_done = nullptr;
+}
+
+void ReadyPipe::close_inherited()
+{
+    // NOLINTNEXTLINE(concurrency-mt-unsafe)
+    const char* value = std::getenv(LAUNCH_READY_FD_ENV);
+    if (!value)
+        return;
+
+    const int fd = std::atoi(value);
+    if (fd > STDERR_FILENO)
+        ::close(fd);
+
+    // NOLINTNEXTLINE(concurrency-mt-unsafe)
+    ::unsetenv(LAUNCH_READY_FD_ENV);
+}
+
+bool ReadyPipe::feed(const char* data, size_t size, LaunchTiming& timing)
+{
+    const auto now = LaunchTiming::Clock::now();
+
+    m_line.append(data, size);
+
+    size_t pos;
+    while ((pos = m_line.find('\n')) != std::string::npos)
+    {
+        const auto message = m_line.substr(0, pos);
+        m_line.erase(0, pos + 1);
+
+        if (message == "exec")
+        {
+            timing.exec = now;
+        }
+        else if (message == "ready")
+        {
+            // an application started without launch.sh only reports this
+            if (timing.exec == LaunchTiming::Clock::time_point())
+                timing.exec = timing.spawned;
+            timing.ready = now;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void ReadyPipe::wait_exec(LaunchTiming& timing, std::chrono::milliseconds timeout)
+{
+    if (!m_read.is_open())
+        return;
+
+    const int fd = m_read.native_handle();
+    const auto deadline = LaunchTiming::Clock::now() + timeout;
+    while (timing.exec == LaunchTiming::Clock::time_point())
+    {
+        const auto left = std::chrono::duration_cast<std::chrono::milliseconds>(
+                              deadline - LaunchTiming::Clock::now()).count();
+        if (left <= 0)
+            break;
+
+        struct pollfd pfd {fd, POLLIN, 0};
+        const int ret = ::poll(&pfd, 1, static_cast<int>(left));
+        if (ret < 0 && errno == EINTR)
+            continue;
+        if (ret <= 0)
+            break;
+
+        const auto n = ::read(fd, m_buffer.data(), m_buffer.size());
+        if (n < 0 && (errno == EINTR || errno == EAGAIN))
+            continue;
+        if (n <= 0)
+            break;
+
+        if (feed(m_buffer.data(), n, timing))
+            break;
+    }
+
+    close();
+}
+
+void ReadyPipe::async_wait(LaunchTiming& timing, std::function<void()> done)
+{
+    if (!m_read.is_open())
+    {
+        done();
+        return;
+    }
+
+    m_done = std::move(done);
+    read(timing);
+}
+
+void ReadyPipe::read(LaunchTiming& timing)
+{
+    m_read.async_read_some(asio::buffer(m_buffer),
+                           [this, &timing](const asio::error_code & ec, std::size_t length)
+    {
+        if (ec == asio::error::operation_aborted)
+            return;
+
+        if (ec || feed(m_buffer.data(), length, timing))
+        {
+            auto done = std::move(m_done);
+            close();
+            if (done)
+                done();
+            return;
+        }
+
+        read(timing);
+    });
+}
+
+/**
+ * Microseconds from start to end, MISSING if either was never reached.
+ */
+static uint32_t elapsed(LaunchTiming::Clock::time_point start,
+                        LaunchTiming::Clock::time_point end)
+{
+    const LaunchTiming::Clock::time_point none;
+    if (start == none || end == none || end < start)
+        return UINT32_MAX;
+
+    const auto us = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+    return static_cast<uint32_t>(std::min<int64_t>(us, UINT32_MAX - 1));
+}
+
+LaunchHistory::LaunchHistory(std::string path)
+    : m_path(std::move(path))
+{}
+
+bool LaunchHistory::open()
+{
+    std::string data;
+    if (m_path.empty() || !read_file(m_path, data))
+        return false;
+
+    CacheReader reader(data.data(), data.size());
+    if (reader.u32() != HISTORY_MAGIC || reader.u32() != HISTORY_VERSION)
+        return false;
+
+    std::map<std::string, std::deque<Sample>> apps;
+    const auto count = reader.u32();
+    for (uint32_t i = 0; i < count && reader.ok(); ++i)
+    {
+        auto app = reader.str();
+        const auto samples = reader.u32();
+        if (samples > MAX_SAMPLES)
+            return false;
+
+        auto& history = apps[std::move(app)];
+        for (uint32_t s = 0; s < samples && reader.ok(); ++s)
+        {
+            Sample sample;
+            sample.teardown = reader.u32();
+            sample.spawn = reader.u32();
+            sample.exec = reader.u32();
+            sample.ready = reader.u32();
+            history.push_back(sample);
+        }
+    }
+
+    if (!reader.ok() || !reader.done())
+        return false;
+
+    m_apps = std::move(apps);
+    return true;
+}
+
+void LaunchHistory::add(const std::string& app, const LaunchTiming& timing)
+{
+    Sample sample;
+    sample.teardown = elapsed(timing.click, timing.spawn);
+    sample.spawn = elapsed(timing.spawn, timing.spawned);
+    sample.exec = elapsed(timing.spawned, timing.exec);
+    sample.ready = elapsed(timing.exec, timing.ready);
+
+    auto& history = m_apps[app];
+    history.push_back(sample);
+    while (history.size() > MAX_SAMPLES)
+        history.pop_front();
+}
+
+bool LaunchHistory::save() const
+{
+    if (m_path.empty())
+        return false;
+
+    CacheWriter writer;
+    writer.u32(HISTORY_MAGIC);
+    writer.u32(HISTORY_VERSION);
+    writer.u32(m_apps.size());
+    for (const auto& app : m_apps)
+    {
+        writer.str(app.first);
+        writer.u32(app.second.size());
+        for (const auto& sample : app.second)
+        {
+            writer.u32(sample.teardown);
+            writer.u32(sample.spawn);
+            writer.u32(sample.exec);
+            writer.u32(sample.ready);
+        }
+    }
+
+    if (!write_file_atomic(m_path, writer.data()))
+    {
+        std::cerr << "cannot write launch history " << m_path << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+const std::array<const char*, LaunchHistory::STAGE_COUNT> LaunchHistory::STAGES =
+{
+    "teardown", "spawn", "exec", "ready", "total"
+};
+
+/**
+ * Percentiles of the reported values, MISSING ones left out.
+ */
+static LaunchHistory::Percentiles percentiles(std::vector<uint32_t> values)
+{
+    values.erase(std::remove(values.begin(), values.end(), UINT32_MAX), values.end());
+
+    LaunchHistory::Percentiles result;
+    result.count = values.size();
+    if (values.empty())
+        return result;
+
+    for (auto value : values)
+        result.sum += value;
+
+    std::sort(values.begin(), values.end());
+    const auto at = [&values](double q)
+    {
+        return values[static_cast<size_t>(q * static_cast<double>(values.size() - 1) + 0.5)];
+    };
+
+    result.p50 = at(0.50);
+    result.p95 = at(0.95);
+    return result;
+}
+
+std::map<std::string, LaunchHistory::Summary> LaunchHistory::summary() const
+{
+    std::map<std::string, Summary> result;
+    for (const auto& app : m_apps)
+    {
+        std::array<std::vector<uint32_t>, STAGE_COUNT> values;
+        for (const auto& sample : app.second)
+        {
+            values[0].push_back(sample.teardown);
+            values[1].push_back(sample.spawn);
+            values[2].push_back(sample.exec);
+            values[3].push_back(sample.ready);
+            if (sample.exec != MISSING && sample.ready != MISSING)
+            {
+                values[4].push_back(static_cast<uint32_t>(
+                                        std::min<uint64_t>(uint64_t(sample.teardown) + sample.spawn +
+                                                sample.exec + sample.ready, MISSING - 1)));
+            }
+        }
+
+        auto& stages = result[app.first];
+        for (size_t stage = 0; stage < STAGE_COUNT; ++stage)
+            stages[stage] = percentiles(std::move(values[stage]));
+    }
+    return result;
+}
+
+void LaunchHistory::report(std::ostream& out) const
+{
+    for (const auto& [app, stages] : summary())
+    {
+        out << app << ": " << stages[0].count << " launches\n"
+            << "  stage       p50 ms   p95 ms\n";
+        for (size_t stage = 0; stage < STAGE_COUNT; ++stage)
+        {
+            const auto& p = stages[stage];
+            out << "  " << std::left << std::setw(10) << STAGES[stage] << std::right;
+            if (!p.count)
+            {
+                out << "        -        -\n";
+                continue;
+            }
+
+            out << std::fixed << std::setprecision(1)
+                << std::setw(9) << p.p50 / 1000.0 << std::setw(9) << p.p95 / 1000.0
+                << "  (" << p.count << ")\n";
+        }
+    }
+}
@@ -0,0 +1,204 @@
+/*
+ * Copyright (C) 2026 Microchip Technology Inc.  All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#ifndef EGT_LAUNCHER_LAUNCHTIMING_H
+#define EGT_LAUNCHER_LAUNCHTIMING_H
+
+#include "process.h"
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <egt/asio.hpp>
+#include <functional>
+#include <map>
+#include <ostream>
+#include <string>
+
+/**
+ * Time points of one launch, from the click on an item until the
+ * application reports it is ready.
+ *
+ * exec and ready stay at their default value when never reported.
+ */
+struct LaunchTiming
+{
+    using Clock = std::chrono::steady_clock;
+
+    /// The item was clicked.
+    Clock::time_point click;
+    /// The launcher is torn down and the shell is about to be spawned.
+    Clock::time_point spawn;
+    /// The spawn call returned.
+    Clock::time_point spawned;
+    /// launch.sh is about to exec the application.
+    Clock::time_point exec;
+    /// The application has shown its first frame.
+    Clock::time_point ready;
+};
+
+/**
+ * Pipe on which a launched application reports its progress.
+ *
+ * The write end is inherited by the child, and its number is passed in
+ * EGT_LAUNCHER_READY_FD. launch.sh writes "exec" on it right before running
+ * the application, which may write "ready" once its first frame is on
+ * screen.
+ */
+class ReadyPipe
+{
+public:
+
+    explicit ReadyPipe(asio::io_context& io);
+
+    ReadyPipe(const ReadyPipe&) = delete;
+    ReadyPipe& operator=(const ReadyPipe&) = delete;
+
+    ~ReadyPipe();
+
+    /**
+     * Create the pipe.
+     */
+    bool open();
+
+    /**
+     * Write end, to be inherited by the child, or -1 if not open.
+     */
+    int write_fd() const { return m_write; }
+
+    /**
+     * Pass the write end to the child in its environment, if open.
+     */
+    void environment(ChildEnvironment& env) const;
+
+    /**
+     * Close the write end once the child has been spawned, so the end of
+     * the child is seen as end of file.
+     */
+    void close_write();
+
+    /**
+     * Block until the application is executed, the pipe is closed, or
+     * timeout, then close the pipe.
+     *
+     * This is for the launcher exiting after a launch, when the event loop
+     * is not running anymore. It does not wait for "ready": the write end
+     * is held by the application until it exits, and the launcher would
+     * keep its memory meanwhile.
+     */
+    void wait_exec(LaunchTiming& timing, std::chrono::milliseconds timeout);
+
+    /**
+     * Read from the event loop, done is called once the application is
+     * ready, or the pipe is closed.
+     */
+    void async_wait(LaunchTiming& timing, std::function<void()> done);
+
+    /**
+     * Close both ends, a pending async_wait() is dropped without calling done.
+     */
+    void close();
+
+    /**
+     * Close a pipe inherited from the launcher which launched this one.
+     */
+    static void close_inherited();
+
+private:
+
+    /**
+     * Time stamp the complete messages of data, returns true once ready.
+     */
+    bool feed(const char* data, size_t size, LaunchTiming& timing);
+
+    void read(LaunchTiming& timing);
+
+    asio::posix::stream_descriptor m_read;
+    int m_write{-1};
+    std::string m_line;
+    std::array<char, 64> m_buffer{};
+    std::function<void()> m_done;
+};
+
+/**
+ * Persistent history of the launch timings of each application.
+ *
+ * The last MAX_SAMPLES launches of each application are kept, and the
+ * report gives the median and 95th percentile of each stage, so a slow
+ * application can be told apart from a slow launcher.
+ */
+class LaunchHistory
+{
+public:
+
+    /// Launches kept per application.
+    static constexpr size_t MAX_SAMPLES = 32;
+
+    /**
+     * @param path History file, empty to disable persistence.
+     */
+    explicit LaunchHistory(std::string path);
+
+    /**
+     * Read the history file, returns false if missing or invalid.
+     */
+    bool open();
+
+    /**
+     * Record a launch of app.
+     */
+    void add(const std::string& app, const LaunchTiming& timing);
+
+    /**
+     * Rewrite the history file.
+     */
+    bool save() const;
+
+    /// Number of stages of a launch.
+    static constexpr size_t STAGE_COUNT = 5;
+
+    /// Names of the stages, the last one is the whole launch.
+    static const std::array<const char*, STAGE_COUNT> STAGES;
+
+    /// Percentiles of a stage in microseconds, over count launches.
+    struct Percentiles
+    {
+        size_t count{0};
+        /// Of all the count launches.
+        double sum{0};
+        double p50{0};
+        double p95{0};
+    };
+
+    using Summary = std::array<Percentiles, STAGE_COUNT>;
+
+    /**
+     * Percentiles of each stage, for every application.
+     */
+    std::map<std::string, Summary> summary() const;
+
+    /**
+     * Print the percentiles of every application.
+     */
+    void report(std::ostream& out) const;
+
+private:
+
+    /// Duration of each stage in microseconds, MISSING if not reported.
+    struct Sample
+    {
+        uint32_t teardown{0};
+        uint32_t spawn{0};
+        uint32_t exec{0};
+        uint32_t ready{0};
+    };
+
+    static constexpr uint32_t MISSING = UINT32_MAX;
+
+    std::string m_path;
+    std::map<std::string, std::deque<Sample>> m_apps;
+};
+
+#endif
@@ -0,0 +1,321 @@
+/*
+ * Copyright (C) 2026 Microchip Technology Inc.  All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "manifest.h"
+#include "memreport.h"
+#include "parallel.h"
+#include "process.h"
+#include "trace.h"
+#include <egt/detail/filesystem.h>
+#include <exception>
+#include <iostream>
+#include <rapidxml.hpp>
+#include <rapidxml_utils.hpp>
+
+/// Identifies the manifest cache file, bump the version on any format change.
+static const uint32_t MANIFEST_CACHE_MAGIC = 0x4d4c4745; // "EGLM"
+static const uint32_t MANIFEST_CACHE_VERSION = 4;
+
+static bool parse_entry(rapidxml::xml_node<>* node, ManifestEntry& entry)
+{
+    if (!node->first_node("title"))
+        return false;
+
+    entry.title = node->first_node("title")->value();
+
+    if (node->first_node("description"))
+        entry.description = node->first_node("description")->value();
+
+    auto link = node->first_node("link");
+    if (link)
+    {
+        auto href = link->first_attribute("href");
+        if (href)
+            entry.image = href->value();
+    }
+
+    if (!node->first_node("arg"))
+        return false;
+
+    entry.arg = node->first_node("arg")->value();
+    split_command(entry.arg, entry.argv);
+
+    auto exit_key = node->first_node("exitkey");
+    if (exit_key && !parse_key_codes(exit_key->value(), entry.exit_keys))
+        std::cerr << "invalid exitkey of " << entry.title << ": " << exit_key->value() << std::endl;
+
+    auto restart = node->first_node("restart");
+    if (restart && !parse_restart_policy(restart->value(), entry.restart))
+        std::cerr << "invalid restart of " << entry.title << ": " << restart->value() << std::endl;
+
+    return true;
+}
+
+std::vector<ManifestEntry> parse_manifest(const std::string& path)
+{
+    Tracer::Scope trace("parse_manifest", "load", path);
+
+    std::vector<ManifestEntry> entries;
+
+    rapidxml::file<> xml_file(path.c_str());
+    rapidxml::xml_document<> doc;
+    doc.parse<0>(xml_file.data());
+
+    auto add = [&entries](rapidxml::xml_node<>* node)
+    {
+        ManifestEntry entry;
+        if (parse_entry(node, entry))
+            entries.push_back(std::move(entry));
+    };
+
+    auto feed = doc.first_node("feed");
+    if (feed)
+    {
+        for (auto screen = feed->first_node("screen"); screen; screen = screen->next_sibling("screen"))
+        {
+            for (auto entry = screen->first_node("entry"); entry; entry = entry->next_sibling("entry"))
+                add(entry);
+        }
+    }
+    else
+    {
+        for (auto entry = doc.first_node("entry"); entry; entry = entry->next_sibling("entry"))
+            add(entry);
+    }
+
+    return entries;
+}
+
+ManifestCache::ManifestCache(std::string path)
+    : m_path(std::move(path))
+{}
+
+bool ManifestCache::open()
+{
+    if (m_path.empty())
+        return false;
+
+    std::string data;
+    if (!read_file(m_path, data))
+        return false;
+
+    CacheReader in(data.data(), data.size());
+    if (in.u32() != MANIFEST_CACHE_MAGIC || in.u32() != MANIFEST_CACHE_VERSION)
+        return false;
+
+    std::unordered_map<std::string, Manifest> manifests;
+    const auto count = in.u32();
+    for (uint32_t i = 0; i < count && in.ok(); ++i)
+    {
+        Manifest manifest;
+        manifest.path = in.str();
+        manifest.dir = in.str();
+        manifest.stamp.mtime = static_cast<int64_t>(in.u64());
+        manifest.stamp.size = in.u64();
+        const auto n = in.u32();
+        for (uint32_t e = 0; e < n && in.ok(); ++e)
+        {
+            ManifestEntry entry;
+            entry.title = in.str();
+            entry.description = in.str();
+            entry.image = in.str();
+            entry.arg = in.str();
+            const auto words = in.u32();
+            for (uint32_t w = 0; w < words && in.ok(); ++w)
+                entry.argv.push_back(in.str());
+            const auto keys = in.u32();
+            for (uint32_t k = 0; k < keys && in.ok(); ++k)
+                entry.exit_keys.push_back(static_cast<uint16_t>(in.u32()));
+            const auto restart = in.u32();
+            if (restart <= static_cast<uint32_t>(RestartPolicy::backoff))
+                entry.restart = static_cast<RestartPolicy>(restart);
+            manifest.entries.push_back(std::move(entry));
+        }
+        auto key = manifest.path;
+        manifests.emplace(std::move(key), std::move(manifest));
+    }
+
+    if (!in.ok() || !in.done())
+    {
+        std::cerr << "ignoring corrupted manifest cache " << m_path << std::endl;
+        return false;
+    }
+
+    m_manifests = std::move(manifests);
+    return true;
+}
+
+bool ManifestCache::save()
+{
+    if (m_path.empty())
+        return false;
+
+    // drop manifests which have not been seen during this run
+    for (auto i = m_manifests.begin(); i != m_manifests.end();)
+    {
+        if (m_used.find(i->first) == m_used.end())
+        {
+            i = m_manifests.erase(i);
+            m_dirty = true;
+        }
+        else
+            ++i;
+    }
+
+    if (!m_dirty)
+        return true;
+
+    CacheWriter out;
+    out.u32(MANIFEST_CACHE_MAGIC);
+    out.u32(MANIFEST_CACHE_VERSION);
+    out.u32(m_manifests.size());
+    for (auto& [path, manifest] : m_manifests)
+    {
+        out.str(manifest.path);
+        out.str(manifest.dir);
+        out.u64(static_cast<uint64_t>(manifest.stamp.mtime));
+        out.u64(manifest.stamp.size);
+        out.u32(manifest.entries.size());
+        for (auto& entry : manifest.entries)
+        {
+            out.str(entry.title);
+            out.str(entry.description);
+            out.str(entry.image);
+            out.str(entry.arg);
+            out.u32(entry.argv.size());
+            for (auto& word : entry.argv)
+                out.str(word);
+            out.u32(entry.exit_keys.size());
+            for (auto key : entry.exit_keys)
+                out.u32(key);
+            out.u32(static_cast<uint32_t>(entry.restart));
+        }
+    }
+
+    if (!write_file_atomic(m_path, out.data()))
+    {
+        std::cerr << "cannot write manifest cache " << m_path << std::endl;
+        return false;
+    }
+
+    m_dirty = false;
+    return true;
+}
+
+void ManifestCache::rescan()
+{
+    m_used.clear();
+}
+
+Manifest ManifestCache::parse(const std::string& file, const FileStamp* stamp)
+{
+    Manifest manifest;
+    manifest.path = file;
+    manifest.dir = egt::detail::extract_dirname(file);
+    try
+    {
+        manifest.entries = parse_manifest(file);
+        // a file that cannot be stat'ed keeps a null stamp, so it is never a hit
+        if (stamp)
+            manifest.stamp = *stamp;
+    }
+    catch (std::exception& e)
+    {
+        std::cerr << "failed to load " << file << ": " << e.what() << std::endl;
+    }
+
+    return manifest;
+}
+
+size_t memory_bytes(const ManifestEntry& entry)
+{
+    size_t bytes = sizeof(entry) + MemoryReport::heap_bytes(entry.title) +
+                   MemoryReport::heap_bytes(entry.description) + MemoryReport::heap_bytes(entry.image) +
+                   MemoryReport::heap_bytes(entry.arg) + entry.argv.capacity() * sizeof(std::string) +
+                   entry.exit_keys.capacity() * sizeof(uint16_t);
+    for (const auto& word : entry.argv)
+        bytes += MemoryReport::heap_bytes(word);
+    return bytes;
+}
+
+size_t ManifestCache::memory_bytes() const
+{
+    // one node per element, and one pointer per bucket
+    size_t bytes = (m_manifests.bucket_count() + m_used.bucket_count()) * sizeof(void*);
+
+    for (const auto& [file, manifest] : m_manifests)
+    {
+        bytes += sizeof(file) + sizeof(manifest) + sizeof(void*) +
+                 MemoryReport::heap_bytes(file) + MemoryReport::heap_bytes(manifest.path) +
+                 MemoryReport::heap_bytes(manifest.dir) +
+                 (manifest.entries.capacity() - manifest.entries.size()) * sizeof(ManifestEntry);
+        for (const auto& entry : manifest.entries)
+            bytes += ::memory_bytes(entry);
+    }
+
+    for (const auto& file : m_used)
+        bytes += sizeof(file) + sizeof(void*) + MemoryReport::heap_bytes(file);
+
+    return bytes;
+}
+
+const Manifest& ManifestCache::get(const std::string& file)
+{
+    return *get(std::vector<std::string>{file}, 1).front();
+}
+
+std::vector<const Manifest*> ManifestCache::get(const std::vector<std::string>& files, unsigned jobs)
+{
+    std::vector<const Manifest*> result(files.size(), nullptr);
+    std::vector<size_t> changed;
+    std::vector<FileStamp> stamps(files.size());
+    std::vector<bool> valid(files.size(), false);
+
+    for (size_t i = 0; i < files.size(); ++i)
+    {
+        auto& file = files[i];
+        m_used.insert(file);
+
+        valid[i] = file_stamp(file, stamps[i]);
+
+        auto m = m_manifests.find(file);
+        if (valid[i] && m != m_manifests.end() && m->second.stamp == stamps[i])
+        {
+            ++m_hits;
+            result[i] = &m->second;
+        }
+        else
+        {
+            ++m_misses;
+            changed.push_back(i);
+        }
+    }
+
+    if (changed.empty())
+        return result;
+
+    std::vector<Manifest> parsed(changed.size());
+    parallel_for(changed.size(), jobs, [&](size_t n)
+    {
+        const auto i = changed[n];
+        parsed[n] = parse(files[i], valid[i] ? &stamps[i] : nullptr);
+    });
+
+    // std::unordered_map never moves its nodes, so earlier pointers are kept
+    for (size_t n = 0; n < changed.size(); ++n)
+    {
+        const auto i = changed[n];
+        auto& slot = m_manifests[files[i]];
+        slot = std::move(parsed[n]);
+        result[i] = &slot;
+        m_dirty = true;
+    }
+
+    return result;
+}
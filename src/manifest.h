@@ -0,0 +1,130 @@
+/*
+ * Copyright (C) 2026 Microchip Technology Inc.  All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#ifndef EGT_LAUNCHER_MANIFEST_H
+#define EGT_LAUNCHER_MANIFEST_H
+
+#include "cache.h"
+#include "keywatch.h"
+#include "supervisor.h"
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+/**
+ * A single launcher <entry> from a manifest.
+ */
+struct ManifestEntry
+{
+    std::string title;
+    std::string description;
+    /// Icon href, relative to the manifest directory or the search paths.
+    std::string image;
+    /// Command line to execute.
+    std::string arg;
+    /// arg split into words, empty if it needs a shell.
+    std::vector<std::string> argv;
+    /// Keys ending the application, from <exitkey>.
+    KeyCodes exit_keys;
+    /// What to do when the application fails, from <restart>.
+    RestartPolicy restart{RestartPolicy::home};
+};
+
+/**
+ * Estimate of the memory held by an entry, its own object included.
+ */
+size_t memory_bytes(const ManifestEntry& entry);
+
+/**
+ * All valid entries of one manifest file.
+ */
+struct Manifest
+{
+    std::string path;
+    /// Directory of the manifest, added to the search paths for its icons.
+    std::string dir;
+    FileStamp stamp;
+    std::vector<ManifestEntry> entries;
+};
+
+/**
+ * Parse a manifest file.
+ *
+ * Entries without a title or an arg are skipped, as they cannot be launched.
+ * Throws on I/O or XML errors.
+ */
+std::vector<ManifestEntry> parse_manifest(const std::string& path);
+
+/**
+ * Persistent cache of parsed manifests.
+ *
+ * Manifests are keyed by path, modification time and size. On a warm start
+ * the whole cache is read from one file and only the manifests that changed
+ * since are parsed again.
+ */
+class ManifestCache
+{
+public:
+
+    /**
+     * @param path Cache file, empty to disable persistence.
+     */
+    explicit ManifestCache(std::string path = {});
+
+    /**
+     * Read the cache file, returns false if missing or invalid.
+     */
+    bool open();
+
+    /**
+     * Write the cache file if anything changed since it was opened.
+     *
+     * Only manifests looked up since open() are kept, so removed files do not
+     * accumulate in the cache.
+     */
+    bool save();
+
+    /**
+     * Start a new scan of all the manifests: only those looked up from now
+     * on are kept by save().
+     */
+    void rescan();
+
+    /**
+     * Get a manifest, parsing it again only if the file changed.
+     */
+    const Manifest& get(const std::string& file);
+
+    /**
+     * Get the manifests of several files, in the same order.
+     *
+     * Files that changed are parsed on up to @p jobs threads, see
+     * parallel_for(). The returned pointers stay valid until the next call
+     * which modifies the cache.
+     */
+    std::vector<const Manifest*> get(const std::vector<std::string>& files, unsigned jobs);
+
+    /**
+     * Estimate of the memory held by the parsed manifests.
+     */
+    size_t memory_bytes() const;
+
+    size_t hits() const { return m_hits; }
+    size_t misses() const { return m_misses; }
+
+private:
+
+    static Manifest parse(const std::string& file, const FileStamp* stamp);
+
+    std::string m_path;
+    std::unordered_map<std::string, Manifest> m_manifests;
+    std::unordered_set<std::string> m_used;
+    bool m_dirty{false};
+    size_t m_hits{0};
+    size_t m_misses{0};
+};
+
+#endif
@@ -0,0 +1,240 @@
+/*
+ * Copyright (C) 2026 Microchip Technology Inc.  All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "memreport.h"
+#include "process.h"
+#include <array>
+#include <fstream>
+#include <malloc.h>
+#include <sstream>
+
+namespace
+{
+
+/**
+ * Kind of a region of /proc/self/smaps.
+ */
+enum class Region
+{
+    heap,
+    anonymous,
+    stack,
+    libraries,
+    fonts,
+    display,
+    files,
+    other,
+};
+
+const std::array<const char*, 8> REGION_NAMES =
+{
+    "heap", "anonymous", "stack", "libraries", "fonts", "display", "files", "other",
+};
+
+bool ends_with(const std::string& str, const char* suffix)
+{
+    const std::string s(suffix);
+    return str.size() >= s.size() && str.compare(str.size() - s.size(), s.size(), s) == 0;
+}
+
+Region classify(const std::string& path)
+{
+    if (path.empty())
+        return Region::anonymous;
+    if (path == "[heap]")
+        return Region::heap;
+    if (path.compare(0, 6, "[stack") == 0)
+        return Region::stack;
+    if (path[0] == '[')
+        return Region::other;
+    if (path.compare(0, 9, "/dev/dri/") == 0 || path.compare(0, 7, "/dev/fb") == 0)
+        return Region::display;
+    for (const auto* suffix : {".ttf", ".otf", ".pfb", ".pcf", ".pcf.gz"})
+    {
+        if (ends_with(path, suffix))
+            return Region::fonts;
+    }
+    if (ends_with(path, ".so") || path.find(".so.") != std::string::npos)
+        return Region::libraries;
+    return Region::files;
+}
+
+struct RegionUsage
+{
+    size_t regions{0};
+    uint64_t rss{0};
+    uint64_t pss{0};
+    uint64_t swap{0};
+};
+
+/**
+ * Sum the regions of /proc/self/smaps by kind, returns false if unreadable.
+ */
+bool read_smaps(std::array<RegionUsage, REGION_NAMES.size()>& usage)
+{
+    std::ifstream in("/proc/self/smaps");
+    if (!in.is_open())
+        return false;
+
+    RegionUsage* region = nullptr;
+    std::string line;
+    while (std::getline(in, line))
+    {
+        std::istringstream fields(line);
+        std::string key;
+        fields >> key;
+        if (key.empty())
+            continue;
+
+        if (key.back() != ':')
+        {
+            // "start-end perms offset dev inode [path]"
+            std::string perms;
+            std::string offset;
+            std::string dev;
+            std::string inode;
+            std::string path;
+            fields >> perms >> offset >> dev >> inode;
+            std::getline(fields >> std::ws, path);
+
+            region = &usage[static_cast<size_t>(classify(path))];
+            ++region->regions;
+            continue;
+        }
+
+        uint64_t kb = 0;
+        if (!region || !(fields >> kb))
+            continue;
+
+        if (key == "Rss:")
+            region->rss += kb * 1024;
+        else if (key == "Pss:")
+            region->pss += kb * 1024;
+        else if (key == "Swap:")
+            region->swap += kb * 1024;
+    }
+
+    return true;
+}
+
+/**
+ * Bytes allocated by malloc and not freed, 0 if unknown.
+ */
+uint64_t heap_in_use()
+{
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 33))
+    const auto info = ::mallinfo2();
+    // large blocks are mapped on their own, out of the arenas
+    return info.uordblks + info.hblkhd;
+#else
+    return 0;
+#endif
+}
+
+const char* storage_name(MemoryReport::Storage storage)
+{
+    return storage == MemoryReport::Storage::mapped ? "mapped" : "heap";
+}
+
+}
+
+void MemoryReport::add(const std::string& subsystem, uint64_t bytes, size_t objects,
+                       Storage storage)
+{
+    auto& usage = m_usage[subsystem];
+    usage.objects += objects;
+    if (storage == Storage::mapped)
+        usage.mapped += bytes;
+    else
+        usage.heap += bytes;
+}
+
+void MemoryReport::detail(const std::string& subsystem, const std::string& name, uint64_t bytes,
+                          Storage storage)
+{
+    add(subsystem, bytes, 1, storage);
+    m_details.push_back({subsystem, name, bytes, storage});
+}
+
+uint64_t MemoryReport::surface(const std::string& subsystem, cairo_surface_t* surface,
+                               Storage storage, const std::string& name)
+{
+    const bool first = surface && m_surfaces.insert(surface).second;
+    const auto bytes = first ? surface_bytes(surface) : 0;
+    if (first)
+        add(subsystem, bytes, 1, storage);
+    if (!name.empty())
+        m_details.push_back({subsystem, name, bytes, storage});
+    return bytes;
+}
+
+void MemoryReport::write(std::ostream& out) const
+{
+    Usage total;
+    for (const auto& [subsystem, usage] : m_usage)
+    {
+        out << "memory subsystem=" << subsystem << " objects=" << usage.objects
+            << " heap_bytes=" << usage.heap << " mapped_bytes=" << usage.mapped << "\n";
+        total.objects += usage.objects;
+        total.heap += usage.heap;
+        total.mapped += usage.mapped;
+    }
+
+    for (const auto& detail : m_details)
+    {
+        out << "memory " << detail.subsystem << "=\"" << detail.name << "\" bytes=" << detail.bytes
+            << " storage=" << storage_name(detail.storage) << "\n";
+    }
+
+    out << "memory accounted objects=" << total.objects << " heap_bytes=" << total.heap
+        << " mapped_bytes=" << total.mapped << "\n";
+
+    const auto in_use = heap_in_use();
+    if (in_use)
+    {
+        out << "memory malloc in_use_bytes=" << in_use << " unaccounted_bytes="
+            << (in_use > total.heap ? in_use - total.heap : 0) << "\n";
+    }
+
+    std::array<RegionUsage, REGION_NAMES.size()> regions{};
+    uint64_t pss = 0;
+    if (read_smaps(regions))
+    {
+        for (size_t i = 0; i < regions.size(); ++i)
+        {
+            const auto& region = regions[i];
+            if (!region.regions)
+                continue;
+
+            out << "memory smaps region=" << REGION_NAMES[i] << " mappings=" << region.regions
+                << " rss_bytes=" << region.rss << " pss_bytes=" << region.pss
+                << " swap_bytes=" << region.swap << "\n";
+            pss += region.pss;
+        }
+    }
+
+    out << "memory rss_bytes=" << resident_memory() << " pss_bytes=" << pss << "\n";
+    out.flush();
+}
+
+uint64_t MemoryReport::heap_bytes(const std::string& str)
+{
+    // short strings are stored in the object itself
+    static const auto inline_capacity = std::string().capacity();
+    return str.capacity() > inline_capacity ? str.capacity() + 1 : 0;
+}
+
+uint64_t MemoryReport::surface_bytes(cairo_surface_t* surface)
+{
+    if (!surface || cairo_surface_get_type(surface) != CAIRO_SURFACE_TYPE_IMAGE)
+        return 0;
+
+    return static_cast<uint64_t>(cairo_image_surface_get_stride(surface)) *
+           cairo_image_surface_get_height(surface);
+}
@@ -0,0 +1,95 @@
+/*
+ * Copyright (C) 2026 Microchip Technology Inc.  All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#ifndef EGT_LAUNCHER_MEMREPORT_H
+#define EGT_LAUNCHER_MEMREPORT_H
+
+#include <cairo.h>
+#include <cstdint>
+#include <map>
+#include <ostream>
+#include <set>
+#include <string>
+#include <vector>
+
+/**
+ * Footprint of the launcher by subsystem, compared to what the allocator
+ * and the kernel see.
+ *
+ * Subsystems account the objects they hold, either on the heap or in a
+ * mapped file. Containers and strings are estimated from their capacity,
+ * without the allocator overhead, so the heap left unaccounted is an upper
+ * bound of what EGT and the libraries hold on their own.
+ */
+class MemoryReport
+{
+public:
+
+    enum class Storage
+    {
+        heap,
+        mapped,
+    };
+
+    /**
+     * Account objects of a subsystem.
+     */
+    void add(const std::string& subsystem, uint64_t bytes, size_t objects = 1,
+             Storage storage = Storage::heap);
+
+    /**
+     * Account an object of a subsystem, which is also listed by name.
+     */
+    void detail(const std::string& subsystem, const std::string& name, uint64_t bytes,
+                Storage storage = Storage::heap);
+
+    /**
+     * Account the pixels of a surface, once however many widgets show it.
+     *
+     * With a name, the surface is also listed, with no bytes if it was
+     * already accounted. Returns the bytes accounted.
+     */
+    uint64_t surface(const std::string& subsystem, cairo_surface_t* surface,
+                     Storage storage = Storage::heap, const std::string& name = {});
+
+    /**
+     * Write the subsystems and the listed objects, then the totals against
+     * the heap in use, the RSS and the regions of /proc/self/smaps.
+     */
+    void write(std::ostream& out) const;
+
+    /**
+     * Bytes a string holds out of its own object.
+     */
+    static uint64_t heap_bytes(const std::string& str);
+
+    /**
+     * Bytes of the pixels of an image surface, 0 for other surfaces.
+     */
+    static uint64_t surface_bytes(cairo_surface_t* surface);
+
+private:
+
+    struct Usage
+    {
+        size_t objects{0};
+        uint64_t heap{0};
+        uint64_t mapped{0};
+    };
+
+    struct Detail
+    {
+        std::string subsystem;
+        std::string name;
+        uint64_t bytes;
+        Storage storage;
+    };
+
+    std::map<std::string, Usage> m_usage;
+    std::vector<Detail> m_details;
+    std::set<const cairo_surface_t*> m_surfaces;
+};
+
+#endif
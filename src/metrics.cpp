@@ -0,0 +1,228 @@
+/*
+ * Copyright (C) 2026 Microchip Technology Inc.  All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "metrics.h"
+#include <array>
+#include <cstdio>
+#include <iostream>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/// Requests larger than this are answered without reading them further.
+static const size_t MAX_REQUEST = 4096;
+
+/// A connection not done within this delay is closed.
+static const std::chrono::milliseconds CONNECTION_TIMEOUT{2000};
+
+void MetricsPage::family(const char* name, const char* type, const char* help)
+{
+    m_text.append("# HELP ").append(name).append(" ").append(help).append("\n");
+    m_text.append("# TYPE ").append(name).append(" ").append(type).append("\n");
+}
+
+void MetricsPage::sample(const std::string& name, double value, const std::string& labels)
+{
+    m_text.append(name);
+    if (!labels.empty())
+        m_text.append("{").append(labels).append("}");
+
+    std::array<char, 32> number{};
+    std::snprintf(number.data(), number.size(), " %.15g\n", value);
+    m_text.append(number.data());
+}
+
+void MetricsPage::histogram(const std::string& name, const Histogram& histogram,
+                            const std::vector<uint64_t>& bounds, const std::string& labels)
+{
+    const auto prefix = labels.empty() ? std::string() : labels + ",";
+
+    for (auto bound : bounds)
+    {
+        std::array<char, 32> le{};
+        std::snprintf(le.data(), le.size(), "%g", bound / 1e6);
+        sample(name + "_bucket", histogram.count_at_most(bound), prefix + label("le", le.data()));
+    }
+    sample(name + "_bucket", histogram.count(), prefix + label("le", "+Inf"));
+    sample(name + "_sum", histogram.sum() / 1e6, labels);
+    sample(name + "_count", histogram.count(), labels);
+}
+
+std::string MetricsPage::label(const char* name, const std::string& value)
+{
+    std::string result(name);
+    result += "=\"";
+    for (auto c : value)
+    {
+        switch (c)
+        {
+        case '\\':
+            result += "\\\\";
+            break;
+        case '"':
+            result += "\\\"";
+            break;
+        case '\n':
+            result += "\\n";
+            break;
+        default:
+            result += c;
+        }
+    }
+    result += '"';
+    return result;
+}
+
+/**
+ * One client, answered once its request is read.
+ */
+class MetricsServer::Connection : public std::enable_shared_from_this<Connection>
+{
+public:
+
+    Connection(asio::local::stream_protocol::socket socket, std::weak_ptr<Collect> collect)
+        : m_socket(std::move(socket)),
+          m_timer(m_socket.get_executor()),
+          m_collect(std::move(collect))
+    {}
+
+    void start()
+    {
+        auto self = shared_from_this();
+        m_timer.expires_after(CONNECTION_TIMEOUT);
+        m_timer.async_wait([self](const asio::error_code & ec)
+        {
+            if (ec)
+                return;
+
+            asio::error_code ignored;
+            self->m_socket.close(ignored);
+        });
+
+        read();
+    }
+
+private:
+
+    void read()
+    {
+        auto self = shared_from_this();
+        m_socket.async_read_some(asio::buffer(m_buffer),
+                                 [self](const asio::error_code & ec, std::size_t length)
+        {
+            if (ec && ec != asio::error::eof)
+            {
+                self->m_timer.cancel();
+                return;
+            }
+
+            self->m_request.append(self->m_buffer.data(), length);
+            if (ec == asio::error::eof ||
+                self->m_request.find("\r\n\r\n") != std::string::npos ||
+                self->m_request.find("\n\n") != std::string::npos ||
+                self->m_request.size() >= MAX_REQUEST)
+            {
+                self->respond();
+                return;
+            }
+
+            self->read();
+        });
+    }
+
+    void respond()
+    {
+        std::string body;
+        if (auto collect = m_collect.lock())
+            body = (*collect)();
+
+        m_response = "HTTP/1.0 200 OK\r\n"
+                     "Content-Type: text/plain; version=0.0.4; charset=utf-8\r\n"
+                     "Content-Length: " + std::to_string(body.size()) + "\r\n"
+                     "Connection: close\r\n"
+                     "\r\n";
+        m_response += body;
+
+        auto self = shared_from_this();
+        asio::async_write(m_socket, asio::buffer(m_response),
+                          [self](const asio::error_code&, std::size_t)
+        {
+            asio::error_code ignored;
+            self->m_socket.close(ignored);
+            self->m_timer.cancel();
+        });
+    }
+
+    asio::local::stream_protocol::socket m_socket;
+    asio::steady_timer m_timer;
+    std::weak_ptr<Collect> m_collect;
+    std::array<char, 512> m_buffer{};
+    std::string m_request;
+    std::string m_response;
+};
+
+MetricsServer::MetricsServer(asio::io_context& io, std::string path, Collect collect)
+    : m_path(std::move(path)),
+      m_collect(std::make_shared<Collect>(std::move(collect))),
+      m_acceptor(io)
+{
+    // a socket left behind by a previous run would make bind() fail, any
+    // other file is not ours to remove
+    struct stat st {};
+    if (::lstat(m_path.c_str(), &st) == 0)
+    {
+        if (!S_ISSOCK(st.st_mode))
+        {
+            std::cerr << "cannot serve metrics on " << m_path << ": not a socket" << std::endl;
+            return;
+        }
+        ::unlink(m_path.c_str());
+    }
+
+    asio::error_code ec;
+    const asio::local::stream_protocol::endpoint endpoint(m_path);
+    m_acceptor.open(endpoint.protocol(), ec);
+    if (!ec)
+        m_acceptor.bind(endpoint, ec);
+    if (!ec)
+        m_acceptor.listen(asio::socket_base::max_listen_connections, ec);
+    if (ec)
+    {
+        std::cerr << "cannot serve metrics on " << m_path << ": " << ec.message() << std::endl;
+        asio::error_code ignored;
+        m_acceptor.close(ignored);
+        return;
+    }
+
+    accept();
+}
+
+MetricsServer::~MetricsServer()
+{
+    if (!m_acceptor.is_open())
+        return;
+
+    asio::error_code ec;
+    m_acceptor.close(ec);
+    ::unlink(m_path.c_str());
+}
+
+void MetricsServer::accept()
+{
+    m_acceptor.async_accept([this](const asio::error_code & ec,
+                                   asio::local::stream_protocol::socket socket)
+    {
+        if (ec == asio::error::operation_aborted)
+            return;
+
+        if (!ec)
+            std::make_shared<Connection>(std::move(socket), m_collect)->start();
+
+        accept();
+    });
+}
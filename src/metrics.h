@@ -0,0 +1,97 @@
+/*
+ * Copyright (C) 2026 Microchip Technology Inc.  All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#ifndef EGT_LAUNCHER_METRICS_H
+#define EGT_LAUNCHER_METRICS_H
+
+#include "histogram.h"
+#include <egt/asio.hpp>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * Page of metrics in the Prometheus text exposition format.
+ */
+class MetricsPage
+{
+public:
+
+    /**
+     * Start a family of samples, type is "counter", "gauge", "histogram"
+     * or "summary".
+     */
+    void family(const char* name, const char* type, const char* help);
+
+    /**
+     * Add a sample, labels are built with label() and comma separated.
+     */
+    void sample(const std::string& name, double value, const std::string& labels = {});
+
+    /**
+     * Add the samples of a histogram of microseconds, in seconds, with a
+     * bucket for each bound.
+     *
+     * A bucket only counts the buckets of the histogram entirely at or
+     * below its bound, see Histogram::count_at_most(): values up to about
+     * 3% below a bound may be left out of its bucket.
+     */
+    void histogram(const std::string& name, const Histogram& histogram,
+                   const std::vector<uint64_t>& bounds, const std::string& labels = {});
+
+    /**
+     * Format a label, escaping its value.
+     */
+    static std::string label(const char* name, const std::string& value);
+
+    const std::string& text() const { return m_text; }
+
+private:
+    std::string m_text;
+};
+
+/**
+ * Serve metrics on a UNIX domain socket, from the event loop.
+ *
+ * Each connection gets the page returned by the collect callback, built
+ * when the request is read, as an HTTP/1.0 response:
+ *
+ *     curl --unix-socket /run/egt-launcher.sock http://localhost/metrics
+ *
+ * Nothing is collected while nobody is connected.
+ */
+class MetricsServer
+{
+public:
+
+    using Collect = std::function<std::string()>;
+
+    /**
+     * Listen on path, replacing a socket left there, but not another file.
+     */
+    MetricsServer(asio::io_context& io, std::string path, Collect collect);
+
+    MetricsServer(const MetricsServer&) = delete;
+    MetricsServer& operator=(const MetricsServer&) = delete;
+
+    /**
+     * Close the socket and remove it from the file system.
+     */
+    ~MetricsServer();
+
+private:
+
+    class Connection;
+
+    void accept();
+
+    std::string m_path;
+    /// Weakly referenced by the connections, which may outlive the server.
+    std::shared_ptr<Collect> m_collect;
+    asio::local::stream_protocol::acceptor m_acceptor;
+};
+
+#endif
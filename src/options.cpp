@@ -0,0 +1,236 @@
+/*
+ * Copyright (C) 2026 Microchip Technology Inc.  All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "cache.h"
+#include "options.h"
+#include <cstdlib>
+#include <getopt.h>
+#include <iostream>
+
+/// Long options without a short one.
+static const int WAIT_PID = 256;
+
+static void usage(const char* name)
+{
+    std::cout << "Usage: " << name << " [OPTION]... [DIR]...\n"
+              << "Search DIR (default: " DATADIR "/egt/) for launcher manifests.\n"
+              << "Directories containing a " << ScanOptions().ignore_file << " file are skipped.\n\n"
+              << "  -c, --cache-dir=DIR   directory of the on-disk caches\n"
+              << "                        (default: " << default_cache_dir() << ")\n"
+              << "  -n, --no-cache        do not read or write the on-disk caches\n"
+              << "  -j, --jobs=N          scan and parse manifests on N threads, 0 for one\n"
+              << "                        per CPU (default: 1)\n"
+              << "  -d, --max-depth=N     do not look for manifests more than N directories\n"
+              << "                        below DIR\n"
+              << "  -p, --prune=PATTERN   do not enter directories matching PATTERN, may be\n"
+              << "                        repeated\n"
+              << "  -w, --watch           reload manifests when they change on disk\n"
+              << "  -r, --resident        stay alive and release the display while an\n"
+              << "                        application runs, instead of exiting\n"
+              << "  -D, --direct-launch   run applications without a shell or launch.sh, when\n"
+              << "                        their command needs no shell\n"
+              << "  -S, --speculate       read the executable and the libraries of an\n"
+              << "                        application when its item is pressed, before the\n"
+              << "                        launch is confirmed\n"
+              << "  -P, --prefork         with -D, also fork the application when its item is\n"
+              << "                        pressed, implies -S\n"
+              << "  -R, --readahead[=MIB] once idle, read the executables and libraries of the\n"
+              << "                        current page which are not cached, up to MIB MiB\n"
+              << "                        per page (default: 16)\n"
+              << "  -l, --lazy-pages      only create the items of the visible page and its\n"
+              << "                        neighbours\n"
+              << "  -s, --snapshot        show the last frame while starting, needs the\n"
+              << "                        on-disk caches\n"
+              << "  -b, --benchmark       load the manifests, print timings and peak memory\n"
+              << "                        use, and exit\n"
+              << "  -f, --frame-stats     record frame times while animating, and print\n"
+              << "                        percentiles on stderr on SIGUSR1\n"
+              << "  -i, --input-latency   measure the latency from input events to the\n"
+              << "                        screen, and print percentiles on stderr on SIGUSR1\n"
+              << "  -a, --alloc-stats     count heap allocations by code path, and print them\n"
+              << "                        on stderr on SIGUSR1\n"
+              << "  -e, --memory-report   print the memory held by each part of the launcher\n"
+              << "                        against the RSS on stderr, on SIGUSR1 and at exit\n"
+              << "  -u, --hud             show the frame rate, CPU and memory use over the\n"
+              << "                        launcher, also toggled by swiping down\n"
+              << "  -L, --launch-timing   time launches until the application is executed,\n"
+              << "                        or with -r until it reports it is ready, and keep\n"
+              << "                        a history in the cache directory\n"
+              << "  -H, --launch-history  print the percentiles of the launch history and exit\n"
+              << "  -m, --metrics=SOCKET  serve metrics in the Prometheus text format on the\n"
+              << "                        UNIX socket SOCKET\n"
+              << "  -t, --profile=FILE    write the timing of the startup phases to FILE as\n"
+              << "                        JSON, - for stderr (default: $EGT_LAUNCHER_PROFILE)\n"
+              << "  -T, --trace=FILE      write a Chrome trace event JSON of the launcher\n"
+              << "                        activity to FILE, %p being the pid, added before\n"
+              << "                        the extension if missing (default:\n"
+              << "                        $EGT_LAUNCHER_TRACE)\n"
+              << "  -M, --trace-marker    mirror the trace events to the kernel trace_marker\n"
+              << "  -v, --verbose         report scan statistics\n"
+              << "  -h, --help            show this help and exit\n";
+}
+
+Options parse_options(int argc, char** argv)
+{
+    Options options;
+    options.cache_dir = default_cache_dir();
+    options.args.assign(argv + 1, argv + argc);
+
+    // NOLINTNEXTLINE(concurrency-mt-unsafe)
+    if (const char* profile = std::getenv("EGT_LAUNCHER_PROFILE"))
+        options.profile = profile;
+
+    // NOLINTNEXTLINE(concurrency-mt-unsafe)
+    if (const char* trace = std::getenv("EGT_LAUNCHER_TRACE"))
+        options.trace = trace;
+
+    static const struct option long_options[] =
+    {
+        {"cache-dir", required_argument, nullptr, 'c'},
+        {"no-cache", no_argument, nullptr, 'n'},
+        {"jobs", required_argument, nullptr, 'j'},
+        {"max-depth", required_argument, nullptr, 'd'},
+        {"prune", required_argument, nullptr, 'p'},
+        {"watch", no_argument, nullptr, 'w'},
+        {"resident", no_argument, nullptr, 'r'},
+        {"direct-launch", no_argument, nullptr, 'D'},
+        {"speculate", no_argument, nullptr, 'S'},
+        {"prefork", no_argument, nullptr, 'P'},
+        {"readahead", optional_argument, nullptr, 'R'},
+        {"lazy-pages", no_argument, nullptr, 'l'},
+        {"snapshot", no_argument, nullptr, 's'},
+        {"benchmark", no_argument, nullptr, 'b'},
+        {"frame-stats", no_argument, nullptr, 'f'},
+        {"input-latency", no_argument, nullptr, 'i'},
+        {"alloc-stats", no_argument, nullptr, 'a'},
+        {"memory-report", no_argument, nullptr, 'e'},
+        {"hud", no_argument, nullptr, 'u'},
+        {"launch-timing", no_argument, nullptr, 'L'},
+        {"launch-history", no_argument, nullptr, 'H'},
+        {"metrics", required_argument, nullptr, 'm'},
+        {"profile", required_argument, nullptr, 't'},
+        {"trace", required_argument, nullptr, 'T'},
+        {"trace-marker", no_argument, nullptr, 'M'},
+        {"verbose", no_argument, nullptr, 'v'},
+        {"help", no_argument, nullptr, 'h'},
+        // internal, see detach() in launcher.cpp
+        {"wait-pid", required_argument, nullptr, WAIT_PID},
+        {nullptr, 0, nullptr, 0},
+    };
+
+    int c;
+    // NOLINTNEXTLINE(concurrency-mt-unsafe)
+    while ((c = getopt_long(argc, argv, "c:nj:d:p:wrDSPR::lsbfiaeuLHm:t:T:Mvh", long_options, nullptr)) != -1)
+    {
+        switch (c)
+        {
+        case 'c':
+            options.cache_dir = optarg;
+            break;
+        case 'n':
+            options.cache_dir.clear();
+            break;
+        case 'j':
+            options.jobs = std::strtoul(optarg, nullptr, 10);
+            break;
+        case 'd':
+            options.scan.max_depth = std::strtol(optarg, nullptr, 10);
+            break;
+        case 'p':
+            options.scan.prune.emplace_back(optarg);
+            break;
+        case 'w':
+            options.watch = true;
+            break;
+        case 'r':
+            options.resident = true;
+            break;
+        case 'D':
+            options.direct_launch = true;
+            break;
+        case 'S':
+            options.speculate = true;
+            break;
+        case 'P':
+            options.speculate = true;
+            options.prefork = true;
+            break;
+        case 'R':
+            options.readahead = (optarg ? std::strtoull(optarg, nullptr, 10) : 16) << 20;
+            break;
+        case 'l':
+            options.lazy_pages = true;
+            break;
+        case 's':
+            options.snapshot = true;
+            break;
+        case 'b':
+            options.benchmark = true;
+            break;
+        case 'f':
+            options.frame_stats = true;
+            break;
+        case 'i':
+            options.input_latency = true;
+            break;
+        case 'a':
+#ifdef ENABLE_ALLOC_STATS
+            options.alloc_stats = true;
+#else
+            std::cerr << "allocation statistics not built in, ignoring --alloc-stats" << std::endl;
+#endif
+            break;
+        case 'e':
+            options.memory_report = true;
+            break;
+        case 'u':
+            options.hud = true;
+            break;
+        case 'L':
+            options.launch_timing = true;
+            break;
+        case 'H':
+            options.launch_history = true;
+            break;
+        case 'm':
+            options.metrics = optarg;
+            break;
+        case 't':
+            options.profile = optarg;
+            break;
+        case 'T':
+            options.trace = optarg;
+            break;
+        case 'M':
+            options.trace_marker = true;
+            break;
+        case 'v':
+            options.verbose = true;
+            break;
+        case WAIT_PID:
+            options.wait_pid = static_cast<pid_t>(std::strtol(optarg, nullptr, 10));
+            break;
+        case 'h':
+            usage(argv[0]);
+            std::exit(EXIT_SUCCESS);
+        default:
+            usage(argv[0]);
+            std::exit(EXIT_FAILURE);
+        }
+    }
+
+    for (auto i = optind; i < argc; i++)
+        options.dirs.emplace_back(argv[i]);
+
+    // load some default directories if nothing is specified
+    if (options.dirs.empty())
+        options.dirs.emplace_back(DATADIR "/egt/");
+
+    return options;
+}
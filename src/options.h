@@ -0,0 +1,83 @@
+/*
+ * Copyright (C) 2026 Microchip Technology Inc.  All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#ifndef EGT_LAUNCHER_OPTIONS_H
+#define EGT_LAUNCHER_OPTIONS_H
+
+#include "scanner.h"
+#include <cstdint>
+#include <string>
+#include <sys/types.h>
+#include <vector>
+
+/**
+ * Command line options of the launcher.
+ */
+struct Options
+{
+    /// Directories searched for manifests.
+    std::vector<std::string> dirs;
+    /// Directory of the on-disk caches, empty when caching is disabled.
+    std::string cache_dir;
+    /// Number of threads used to parse manifests, 0 for one per CPU.
+    unsigned jobs{1};
+    /// Tuning of the manifest directory scan.
+    ScanOptions scan;
+    /// Report scan statistics on stderr.
+    bool verbose{false};
+    /// Reload manifests when they change on disk.
+    bool watch{false};
+    /// Stay alive while an application runs, instead of exiting.
+    bool resident{false};
+    /// Run applications without a shell or launch.sh when their command allows it.
+    bool direct_launch{false};
+    /// Prefetch the files of an application when its item is pressed.
+    bool speculate{false};
+    /// Also fork the application when its item is pressed, with direct_launch.
+    bool prefork{false};
+    /// I/O budget in bytes to read ahead the applications of the current page, 0 for none.
+    uint64_t readahead{0};
+    /// Only wait for this application, then start the launcher again.
+    pid_t wait_pid{-1};
+    /// Only create the widgets of the visible page and its neighbours.
+    bool lazy_pages{false};
+    /// Show a snapshot of the last frame while starting.
+    bool snapshot{false};
+    /// Load the manifests, report timings and memory use on stdout, and exit.
+    bool benchmark{false};
+    /// Record frame times while animating, reported on SIGUSR1.
+    bool frame_stats{false};
+    /// Measure input to photon latency, reported on SIGUSR1.
+    bool input_latency{false};
+    /// Count heap allocations by code path, reported on SIGUSR1.
+    bool alloc_stats{false};
+    /// Report the memory held by each part of the launcher, on SIGUSR1 and at exit.
+    bool memory_report{false};
+    /// Show the performance overlay, also toggled by swiping down.
+    bool hud{false};
+    /// Time launches and keep a per-application history in the cache directory.
+    bool launch_timing{false};
+    /// Print the launch history and exit.
+    bool launch_history{false};
+    /// UNIX socket the metrics are served on, empty for none.
+    std::string metrics;
+    /// File the Chrome trace events are written to, empty for none.
+    std::string trace;
+    /// Mirror the trace events to the ftrace trace_marker.
+    bool trace_marker{false};
+    /// File the startup profile is written to, "-" for stderr, empty for none.
+    std::string profile;
+    /// Command line arguments, for launch.sh to start the launcher again.
+    std::vector<std::string> args;
+};
+
+/**
+ * Parse the command line.
+ *
+ * Exits on --help or on an invalid option.
+ */
+Options parse_options(int argc, char** argv);
+
+#endif
@@ -0,0 +1,50 @@
+/*
+ * Copyright (C) 2026 Microchip Technology Inc.  All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "parallel.h"
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+unsigned resolve_jobs(unsigned jobs)
+{
+    if (jobs)
+        return jobs;
+
+    return std::max(1U, std::thread::hardware_concurrency());
+}
+
+void parallel_for(size_t count, unsigned jobs, const std::function<void(size_t)>& func)
+{
+    const auto workers = std::min<size_t>(resolve_jobs(jobs), count);
+    if (workers <= 1)
+    {
+        for (size_t i = 0; i < count; ++i)
+            func(i);
+        return;
+    }
+
+    std::atomic<size_t> next{0};
+    auto worker = [&next, count, &func]()
+    {
+        for (auto i = next++; i < count; i = next++)
+            func(i);
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(workers - 1);
+    for (size_t t = 1; t < workers; ++t)
+        threads.emplace_back(worker);
+
+    worker();
+
+    for (auto& thread : threads)
+        thread.join();
+}
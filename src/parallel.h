@@ -0,0 +1,26 @@
+/*
+ * Copyright (C) 2026 Microchip Technology Inc.  All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#ifndef EGT_LAUNCHER_PARALLEL_H
+#define EGT_LAUNCHER_PARALLEL_H
+
+#include <cstddef>
+#include <functional>
+
+/**
+ * Resolve a requested number of jobs, 0 meaning one per online CPU.
+ */
+unsigned resolve_jobs(unsigned jobs);
+
+/**
+ * Invoke func(index) for every index in [0, count) on a pool of workers.
+ *
+ * The calling thread is one of the workers, so with jobs <= 1 or a single
+ * item everything runs inline without creating any thread. Items are handed
+ * out in increasing order, but may complete in any order.
+ */
+void parallel_for(size_t count, unsigned jobs, const std::function<void(size_t)>& func);
+
+#endif
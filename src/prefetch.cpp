@@ -0,0 +1,580 @@
+/*
+ * Copyright (C) 2026 Microchip Technology Inc.  All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "prefetch.h"
+#include "trace.h"
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <elf.h>
+#include <fcntl.h>
+#include <fstream>
+#include <glob.h>
+#include <set>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace
+{
+
+/**
+ * Closes a file descriptor on scope exit.
+ */
+struct FileDescriptor
+{
+    explicit FileDescriptor(int fd)
+        : fd(fd)
+    {}
+
+    FileDescriptor(const FileDescriptor&) = delete;
+    FileDescriptor& operator=(const FileDescriptor&) = delete;
+
+    ~FileDescriptor()
+    {
+        if (fd >= 0)
+            ::close(fd);
+    }
+
+    int fd;
+};
+
+bool read_at(int fd, void* data, size_t size, uint64_t offset)
+{
+    return ::pread(fd, data, size, static_cast<off_t>(offset)) == static_cast<ssize_t>(size);
+}
+
+std::vector<std::string> split_path(const std::string& list, const std::string& origin)
+{
+    std::vector<std::string> dirs;
+    size_t start = 0;
+    while (start <= list.size())
+    {
+        auto end = list.find(':', start);
+        if (end == std::string::npos)
+            end = list.size();
+
+        auto dir = list.substr(start, end - start);
+        for (const auto* token : {"$ORIGIN", "${ORIGIN}"})
+        {
+            const auto pos = dir.find(token);
+            if (pos != std::string::npos)
+                dir.replace(pos, std::strlen(token), origin);
+        }
+        if (!dir.empty())
+            dirs.push_back(dir);
+
+        start = end + 1;
+    }
+    return dirs;
+}
+
+/**
+ * What the loader needs to know about an ELF file.
+ */
+struct ElfInfo
+{
+    std::string interpreter;
+    std::vector<std::string> needed;
+    std::string rpath;
+    std::string runpath;
+};
+
+template<class Ehdr, class Phdr, class Dyn>
+bool read_elf(int fd, ElfInfo& info)
+{
+    Ehdr ehdr;
+    if (!read_at(fd, &ehdr, sizeof(ehdr), 0) || ehdr.e_phentsize != sizeof(Phdr))
+        return false;
+
+    std::vector<Phdr> phdrs(ehdr.e_phnum);
+    if (!read_at(fd, phdrs.data(), phdrs.size() * sizeof(Phdr), ehdr.e_phoff))
+        return false;
+
+    const Phdr* dynamic = nullptr;
+    for (const auto& phdr : phdrs)
+    {
+        if (phdr.p_type == PT_DYNAMIC)
+            dynamic = &phdr;
+        else if (phdr.p_type == PT_INTERP && phdr.p_filesz > 1 && phdr.p_filesz < 4096)
+        {
+            info.interpreter.resize(phdr.p_filesz - 1);
+            if (!read_at(fd, &info.interpreter[0], info.interpreter.size(), phdr.p_offset))
+                info.interpreter.clear();
+        }
+    }
+
+    if (!dynamic || dynamic->p_filesz > (1 << 20))
+        return true;
+
+    std::vector<Dyn> dyns(dynamic->p_filesz / sizeof(Dyn));
+    if (!read_at(fd, dyns.data(), dyns.size() * sizeof(Dyn), dynamic->p_offset))
+        return false;
+
+    uint64_t strtab = 0;
+    uint64_t strsz = 0;
+    std::vector<uint64_t> needed;
+    uint64_t rpath = UINT64_MAX;
+    uint64_t runpath = UINT64_MAX;
+    for (const auto& dyn : dyns)
+    {
+        if (dyn.d_tag == DT_NULL)
+            break;
+
+        switch (dyn.d_tag)
+        {
+        case DT_STRTAB:
+            strtab = dyn.d_un.d_ptr;
+            break;
+        case DT_STRSZ:
+            strsz = dyn.d_un.d_val;
+            break;
+        case DT_NEEDED:
+            needed.push_back(dyn.d_un.d_val);
+            break;
+        case DT_RPATH:
+            rpath = dyn.d_un.d_val;
+            break;
+        case DT_RUNPATH:
+            runpath = dyn.d_un.d_val;
+            break;
+        default:
+            break;
+        }
+    }
+
+    // the string table is given as an address, found in the file through its segment
+    uint64_t offset = UINT64_MAX;
+    for (const auto& phdr : phdrs)
+    {
+        if (phdr.p_type == PT_LOAD && strtab >= phdr.p_vaddr &&
+            strtab < phdr.p_vaddr + phdr.p_filesz)
+        {
+            offset = strtab - phdr.p_vaddr + phdr.p_offset;
+            break;
+        }
+    }
+
+    if (offset == UINT64_MAX || !strsz || strsz > (1 << 20))
+        return true;
+
+    std::string strings(strsz, '\0');
+    if (!read_at(fd, &strings[0], strings.size(), offset))
+        return false;
+
+    auto string_at = [&strings](uint64_t index)
+    {
+        return index < strings.size() ? std::string(strings.c_str() + index) : std::string();
+    };
+
+    for (auto index : needed)
+        info.needed.push_back(string_at(index));
+    if (rpath != UINT64_MAX)
+        info.rpath = string_at(rpath);
+    if (runpath != UINT64_MAX)
+        info.runpath = string_at(runpath);
+    return true;
+}
+
+bool read_elf(const std::string& path, ElfInfo& info)
+{
+    const FileDescriptor file(::open(path.c_str(), O_RDONLY | O_CLOEXEC));
+    if (file.fd < 0)
+        return false;
+
+    unsigned char ident[EI_NIDENT];
+    if (!read_at(file.fd, ident, sizeof(ident), 0) || std::memcmp(ident, ELFMAG, SELFMAG) != 0)
+        return false;
+
+    // only files of the running architecture can be loaded
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    if (ident[EI_DATA] != ELFDATA2LSB)
+        return false;
+#else
+    if (ident[EI_DATA] != ELFDATA2MSB)
+        return false;
+#endif
+
+    if (ident[EI_CLASS] == ELFCLASS64)
+        return read_elf<Elf64_Ehdr, Elf64_Phdr, Elf64_Dyn>(file.fd, info);
+    if (ident[EI_CLASS] == ELFCLASS32)
+        return read_elf<Elf32_Ehdr, Elf32_Phdr, Elf32_Dyn>(file.fd, info);
+    return false;
+}
+
+/**
+ * Append the directories listed in an ld.so.conf file, following includes.
+ */
+void read_ld_so_conf(const std::string& path, std::vector<std::string>& dirs, unsigned depth = 0)
+{
+    std::ifstream in(path);
+    std::string line;
+    while (depth < 4 && std::getline(in, line))
+    {
+        line = line.substr(0, line.find('#'));
+        const auto start = line.find_first_not_of(" \t");
+        if (start == std::string::npos)
+            continue;
+        const auto end = line.find_last_not_of(" \t\r");
+        line = line.substr(start, end - start + 1);
+
+        if (line.compare(0, 8, "include ") == 0)
+        {
+            auto pattern = line.substr(line.find_first_not_of(" \t", 8));
+            if (pattern[0] != '/')
+                pattern = "/etc/" + pattern;
+
+            glob_t files{};
+            if (::glob(pattern.c_str(), 0, nullptr, &files) == 0)
+            {
+                for (size_t i = 0; i < files.gl_pathc; ++i)
+                    read_ld_so_conf(files.gl_pathv[i], dirs, depth + 1);
+            }
+            ::globfree(&files);
+        }
+        else if (line[0] == '/')
+        {
+            dirs.push_back(line);
+        }
+    }
+}
+
+const std::vector<std::string>& system_library_dirs()
+{
+    static const std::vector<std::string> dirs = []()
+    {
+        std::vector<std::string> dirs;
+        read_ld_so_conf("/etc/ld.so.conf", dirs);
+        for (const auto* dir : {"/lib", "/usr/lib", "/lib64", "/usr/lib64"})
+            dirs.emplace_back(dir);
+        return dirs;
+    }();
+    return dirs;
+}
+
+bool is_file(const std::string& path)
+{
+    struct stat st {};
+    return ::stat(path.c_str(), &st) == 0 && S_ISREG(st.st_mode);
+}
+
+/**
+ * Path without symbolic links, so that a library is read once whatever its
+ * name.
+ */
+std::string canonical(const std::string& path)
+{
+    char* real = ::realpath(path.c_str(), nullptr);
+    if (!real)
+        return path;
+
+    std::string result(real);
+    std::free(real);
+    return result;
+}
+
+std::string dirname(const std::string& path)
+{
+    const auto slash = path.rfind('/');
+    return slash == std::string::npos ? std::string(".") : path.substr(0, slash);
+}
+
+}
+
+std::string find_executable(const std::string& name)
+{
+    if (name.empty())
+        return {};
+
+    if (name.find('/') != std::string::npos)
+        return ::access(name.c_str(), X_OK) == 0 ? name : std::string();
+
+    // NOLINTNEXTLINE(concurrency-mt-unsafe)
+    const char* path = std::getenv("PATH");
+    for (const auto& dir : split_path(path ? path : "/bin:/usr/bin", {}))
+    {
+        auto file = dir + "/" + name;
+        if (::access(file.c_str(), X_OK) == 0 && is_file(file))
+            return file;
+    }
+
+    return {};
+}
+
+std::vector<std::string> shared_libraries(const std::string& path)
+{
+    // NOLINTNEXTLINE(concurrency-mt-unsafe)
+    const char* env = std::getenv("LD_LIBRARY_PATH");
+    const auto library_path = split_path(env ? env : "", {});
+
+    std::vector<std::string> libraries;
+    std::set<std::string> seen{path};
+    std::deque<std::string> queue{path};
+    while (!queue.empty())
+    {
+        const auto file = queue.front();
+        queue.pop_front();
+
+        ElfInfo info;
+        if (!read_elf(file, info))
+            continue;
+
+        const auto interpreter = info.interpreter.empty() ? info.interpreter :
+                                 canonical(info.interpreter);
+        if (!interpreter.empty() && seen.insert(interpreter).second)
+        {
+            libraries.push_back(interpreter);
+            queue.push_back(interpreter);
+        }
+
+        std::vector<std::string> dirs;
+        const auto origin = dirname(file);
+        if (info.runpath.empty())
+            dirs = split_path(info.rpath, origin);
+        dirs.insert(dirs.end(), library_path.begin(), library_path.end());
+        const auto runpath = split_path(info.runpath, origin);
+        dirs.insert(dirs.end(), runpath.begin(), runpath.end());
+        const auto& system = system_library_dirs();
+        dirs.insert(dirs.end(), system.begin(), system.end());
+
+        for (const auto& name : info.needed)
+        {
+            std::string found;
+            if (name.find('/') != std::string::npos)
+            {
+                if (is_file(name))
+                    found = canonical(name);
+            }
+            else
+            {
+                for (const auto& dir : dirs)
+                {
+                    auto candidate = dir + "/" + name;
+                    if (is_file(candidate))
+                    {
+                        found = canonical(candidate);
+                        break;
+                    }
+                }
+            }
+
+            if (!found.empty() && seen.insert(found).second)
+            {
+                libraries.push_back(found);
+                queue.push_back(found);
+            }
+        }
+    }
+
+    return libraries;
+}
+
+uint64_t readahead_file(const std::string& path, uint64_t budget, uint64_t& cached)
+{
+    cached = 0;
+
+    const FileDescriptor file(::open(path.c_str(), O_RDONLY | O_CLOEXEC));
+    if (file.fd < 0)
+        return 0;
+
+    struct stat st {};
+    if (::fstat(file.fd, &st) != 0 || st.st_size <= 0)
+        return 0;
+
+    const auto size = static_cast<uint64_t>(st.st_size);
+    const auto page = static_cast<uint64_t>(::sysconf(_SC_PAGESIZE));
+    std::vector<unsigned char> resident((size + page - 1) / page);
+
+    // mapping the file reads nothing, mincore() tells which pages are cached
+    void* map = ::mmap(nullptr, size, PROT_READ, MAP_SHARED, file.fd, 0);
+    if (map == MAP_FAILED)
+        return 0;
+    const bool known = ::mincore(map, size, resident.data()) == 0;
+    ::munmap(map, size);
+    if (!known)
+        std::fill(resident.begin(), resident.end(), 0);
+
+    // queue the reads of the runs of missing pages, they stay cached once
+    // the file is closed
+    uint64_t asked = 0;
+    size_t index = 0;
+    while (index < resident.size() && asked < budget)
+    {
+        if (resident[index] & 1)
+        {
+            cached += std::min(page, size - index * page);
+            ++index;
+            continue;
+        }
+
+        const auto first = index;
+        while (index < resident.size() && !(resident[index] & 1))
+            ++index;
+
+        const auto offset = first * page;
+        const auto length = std::min({(index - first) * page, size - offset, budget - asked});
+        ::posix_fadvise(file.fd, static_cast<off_t>(offset), static_cast<off_t>(length),
+                        POSIX_FADV_WILLNEED);
+        asked += length;
+    }
+
+    return asked;
+}
+
+Prefetcher::~Prefetcher()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+        ++m_generation;
+        ++m_idle_generation;
+    }
+    m_cond.notify_one();
+
+    if (m_thread.joinable())
+        m_thread.join();
+}
+
+void Prefetcher::request(const std::string& command)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_pending = command;
+        ++m_generation;
+        if (!m_thread.joinable())
+            m_thread = std::thread(&Prefetcher::run, this);
+    }
+    m_cond.notify_one();
+}
+
+void Prefetcher::cancel()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_pending.clear();
+    ++m_generation;
+}
+
+void Prefetcher::idle(const std::vector<std::string>& commands, uint64_t budget)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_idle.assign(commands.begin(), commands.end());
+        m_idle_budget = budget;
+        ++m_idle_generation;
+        if (!m_thread.joinable())
+            m_thread = std::thread(&Prefetcher::run, this);
+    }
+    m_cond.notify_one();
+}
+
+void Prefetcher::cancel_idle()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_idle.clear();
+    ++m_idle_generation;
+}
+
+const std::vector<std::string>& Prefetcher::closure(const std::string& command)
+{
+    auto closure = m_closures.find(command);
+    if (closure == m_closures.end())
+    {
+        std::vector<std::string> files;
+        const auto exe = find_executable(command);
+        if (!exe.empty())
+        {
+            files.push_back(exe);
+            const auto libraries = shared_libraries(exe);
+            files.insert(files.end(), libraries.begin(), libraries.end());
+        }
+        closure = m_closures.emplace(command, std::move(files)).first;
+    }
+    return closure->second;
+}
+
+void Prefetcher::run()
+{
+    Tracer::instance().thread_name("prefetch");
+
+    while (true)
+    {
+        std::string command;
+        bool idle = false;
+        uint64_t generation = 0;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_cond.wait(lock, [this]()
+            {
+                return m_stop || !m_pending.empty() || (!m_idle.empty() && m_idle_budget);
+            });
+            if (m_stop)
+                return;
+
+            if (!m_pending.empty())
+            {
+                command = std::move(m_pending);
+                m_pending.clear();
+                generation = m_generation;
+            }
+            else
+            {
+                command = std::move(m_idle.front());
+                m_idle.pop_front();
+                idle = true;
+                generation = m_idle_generation;
+            }
+        }
+
+        Tracer::Scope trace(idle ? "prefetch_idle" : "prefetch", "launch", command);
+
+        for (const auto& file : closure(command))
+        {
+            uint64_t budget = UINT64_MAX;
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                if (idle)
+                {
+                    // a request goes first, the files already read are then skipped
+                    if (m_idle_generation == generation && !m_pending.empty())
+                        m_idle.push_front(command);
+                    if (m_idle_generation != generation || !m_pending.empty() || !m_idle_budget)
+                        break;
+                    budget = m_idle_budget;
+                }
+                else if (m_generation != generation)
+                {
+                    break;
+                }
+            }
+
+            uint64_t cached = 0;
+            const auto bytes = readahead_file(file, budget, cached);
+            ++m_files_read;
+            m_bytes_read += bytes;
+            m_bytes_cached += cached;
+
+            if (!idle)
+                continue;
+
+            std::unique_lock<std::mutex> lock(m_mutex);
+            if (m_idle_generation == generation)
+                m_idle_budget -= std::min(bytes, m_idle_budget);
+
+            // give the reads some time, and wake up on a request or a cancel
+            if (bytes)
+            {
+                m_cond.wait_for(lock, IDLE_PAUSE, [this, generation]()
+                {
+                    return m_stop || m_idle_generation != generation || !m_pending.empty();
+                });
+            }
+        }
+    }
+}
@@ -0,0 +1,124 @@
+/*
+ * Copyright (C) 2026 Microchip Technology Inc.  All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#ifndef EGT_LAUNCHER_PREFETCH_H
+#define EGT_LAUNCHER_PREFETCH_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * Look a command up in PATH like execvp() does, returns an empty string if
+ * it is not found.
+ */
+std::string find_executable(const std::string& name);
+
+/**
+ * The dynamic loader and the shared libraries an ELF file needs, directly
+ * or not, resolved like ld.so does: RPATH, LD_LIBRARY_PATH, RUNPATH, then
+ * the directories of /etc/ld.so.conf and the default ones.
+ *
+ * Libraries which cannot be found are skipped.
+ */
+std::vector<std::string> shared_libraries(const std::string& path);
+
+/**
+ * Ask the kernel to read the parts of a file missing from the page cache,
+ * without waiting for them, stopping once budget bytes are asked.
+ *
+ * Returns the bytes asked to be read, cached is set to the bytes which
+ * already were.
+ */
+uint64_t readahead_file(const std::string& path, uint64_t budget, uint64_t& cached);
+
+/**
+ * Reads the executables of commands and their shared libraries into the
+ * page cache on a background thread, so that starting them reads less from
+ * storage.
+ *
+ * A request, for a pressed item, comes first. Only the last one is kept: a
+ * new one replaces the pending one, and stops the one in progress between
+ * two files. Idle requests, for the items in view, are only served when
+ * there is no request, one file at a time, until their I/O budget is
+ * spent.
+ */
+class Prefetcher
+{
+public:
+
+    Prefetcher() = default;
+
+    Prefetcher(const Prefetcher&) = delete;
+    Prefetcher& operator=(const Prefetcher&) = delete;
+
+    ~Prefetcher();
+
+    /**
+     * Queue the files of a command, argv[0] being looked up in PATH.
+     */
+    void request(const std::string& command);
+
+    /**
+     * Drop the pending request, and stop the one in progress.
+     */
+    void cancel();
+
+    /**
+     * Replace the idle requests by commands, reading at most budget bytes
+     * from storage for all of them.
+     */
+    void idle(const std::vector<std::string>& commands, uint64_t budget);
+
+    /**
+     * Drop the idle requests, and stop the one in progress.
+     */
+    void cancel_idle();
+
+    /**
+     * Files and bytes asked to be read so far, and bytes found cached.
+     */
+    uint64_t files() const { return m_files_read; }
+    uint64_t bytes() const { return m_bytes_read; }
+    uint64_t cached_bytes() const { return m_bytes_cached; }
+
+    /// Pause between two files of idle requests, to leave storage to others.
+    static constexpr std::chrono::milliseconds IDLE_PAUSE{20};
+
+private:
+
+    /**
+     * Resolve the files of a command once, on the worker.
+     */
+    const std::vector<std::string>& closure(const std::string& command);
+
+    void run();
+
+    std::mutex m_mutex;
+    std::condition_variable m_cond;
+    std::string m_pending;
+    /// Changed by every request and cancel, to stop the one in progress.
+    uint64_t m_generation{0};
+    std::deque<std::string> m_idle;
+    uint64_t m_idle_budget{0};
+    /// Changed by every idle request and cancel_idle().
+    uint64_t m_idle_generation{0};
+    bool m_stop{false};
+    std::thread m_thread;
+    /// Files of each command, resolved once, only used by the worker.
+    std::map<std::string, std::vector<std::string>> m_closures;
+    std::atomic<uint64_t> m_files_read{0};
+    std::atomic<uint64_t> m_bytes_read{0};
+    std::atomic<uint64_t> m_bytes_cached{0};
+};
+
+#endif
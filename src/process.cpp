@@ -0,0 +1,503 @@
+/*
+ * Copyright (C) 2026 Microchip Technology Inc.  All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "process.h"
+#include <cerrno>
+#include <csignal>
+#include <cstring>
+#include <fcntl.h>
+#include <fstream>
+#include <iostream>
+#include <spawn.h>
+#include <sys/prctl.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#ifndef SYS_pidfd_open
+#define SYS_pidfd_open 434
+#endif
+
+// posix_spawn() closes the inherited file descriptors since glibc 2.34
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 34))
+#define HAVE_SPAWN_CLOSEFROM 1
+#endif
+
+uint64_t resident_memory()
+{
+    std::ifstream in("/proc/self/statm");
+    uint64_t size = 0;
+    uint64_t resident = 0;
+    if (!(in >> size >> resident))
+        return 0;
+
+    return resident * ::sysconf(_SC_PAGESIZE);
+}
+
+int pidfd_open(pid_t pid)
+{
+    return static_cast<int>(::syscall(SYS_pidfd_open, pid, 0));
+}
+
+void close_inherited_fds(int keep_fd)
+{
+#ifdef SYS_close_range
+    if (keep_fd <= STDERR_FILENO)
+    {
+        if (::syscall(SYS_close_range, 3U, ~0U, 0U) == 0)
+            return;
+    }
+    else if ((keep_fd == 3 || ::syscall(SYS_close_range, 3U, keep_fd - 1U, 0U) == 0) &&
+             ::syscall(SYS_close_range, keep_fd + 1U, ~0U, 0U) == 0)
+    {
+        return;
+    }
+#endif
+
+    struct rlimit rl {};
+    int max = 1024;
+    if (getrlimit(RLIMIT_NOFILE, &rl) == 0 && rl.rlim_cur != RLIM_INFINITY)
+        max = static_cast<int>(rl.rlim_cur);
+
+    for (int fd = 3; fd < max; ++fd)
+    {
+        if (fd != keep_fd)
+            ::close(fd);
+    }
+}
+
+/**
+ * Prepare a forked child to run an application, like launch.sh does.
+ */
+static void setup_child(int keep_fd)
+{
+    const int null = ::open("/dev/null", O_RDWR);
+    if (null >= 0)
+    {
+        ::dup2(null, STDOUT_FILENO);
+        ::dup2(null, STDERR_FILENO);
+    }
+    ::close(STDIN_FILENO);
+    close_inherited_fds(keep_fd);
+    ::setsid();
+}
+
+void ChildEnvironment::set(const std::string& name, const std::string& value)
+{
+    m_vars[name] = value;
+}
+
+char* const* ChildEnvironment::envp() const
+{
+    m_strings.clear();
+    for (char** var = environ; *var; ++var)
+    {
+        const char* equal = std::strchr(*var, '=');
+        const std::string name(*var, equal ? equal - *var : std::strlen(*var));
+        if (m_vars.find(name) == m_vars.end())
+            m_strings.emplace_back(*var);
+    }
+    for (const auto& [name, value] : m_vars)
+        m_strings.push_back(name + "=" + value);
+
+    m_envp.clear();
+    for (auto& var : m_strings)
+        m_envp.push_back(&var[0]);
+    m_envp.push_back(nullptr);
+    return m_envp.data();
+}
+
+std::string ChildEnvironment::assignments() const
+{
+    std::string result;
+    for (const auto& [name, value] : m_vars)
+        result += name + "=" + shell_quote(value) + " ";
+    return result;
+}
+
+std::string shell_quote(const std::string& word)
+{
+    std::string result = "'";
+    for (auto c : word)
+    {
+        if (c == '\'')
+            result += "'\\''";
+        else
+            result += c;
+    }
+    result += "'";
+    return result;
+}
+
+pid_t spawn_process(const std::vector<std::string>& argv, int keep_fd, const ChildEnvironment& env)
+{
+    if (argv.empty())
+        return -1;
+
+    std::vector<char*> args;
+    for (const auto& arg : argv)
+        args.push_back(const_cast<char*>(arg.c_str()));
+    args.push_back(nullptr);
+
+#ifdef HAVE_SPAWN_CLOSEFROM
+    posix_spawn_file_actions_t actions;
+    ::posix_spawn_file_actions_init(&actions);
+    ::posix_spawn_file_actions_addclose(&actions, STDIN_FILENO);
+    ::posix_spawn_file_actions_addopen(&actions, STDOUT_FILENO, "/dev/null", O_WRONLY, 0);
+    ::posix_spawn_file_actions_adddup2(&actions, STDOUT_FILENO, STDERR_FILENO);
+    if (keep_fd > STDERR_FILENO)
+    {
+        for (int fd = STDERR_FILENO + 1; fd < keep_fd; ++fd)
+            ::posix_spawn_file_actions_addclose(&actions, fd);
+        ::posix_spawn_file_actions_addclosefrom_np(&actions, keep_fd + 1);
+    }
+    else
+    {
+        ::posix_spawn_file_actions_addclosefrom_np(&actions, STDERR_FILENO + 1);
+    }
+
+    posix_spawnattr_t attr;
+    ::posix_spawnattr_init(&attr);
+    sigset_t mask;
+    sigemptyset(&mask);
+    ::posix_spawnattr_setsigmask(&attr, &mask);
+    sigset_t defaults;
+    sigfillset(&defaults);
+    ::posix_spawnattr_setsigdefault(&attr, &defaults);
+    ::posix_spawnattr_setflags(&attr, POSIX_SPAWN_SETSID | POSIX_SPAWN_SETSIGMASK |
+                               POSIX_SPAWN_SETSIGDEF);
+
+    // the parent is only suspended until the child has executed argv
+    pid_t pid = -1;
+    const int error = ::posix_spawnp(&pid, args[0], &actions, &attr, args.data(), env.envp());
+    ::posix_spawnattr_destroy(&attr);
+    ::posix_spawn_file_actions_destroy(&actions);
+
+    if (error)
+    {
+        std::cerr << "cannot run " << argv[0] << ": " << std::strerror(error) << std::endl;
+        return -1;
+    }
+
+    return pid;
+#else
+    char* const* envp = env.envp();
+    const pid_t pid = ::fork();
+    if (pid < 0)
+    {
+        std::cerr << "fork: " << std::strerror(errno) << std::endl;
+        return -1;
+    }
+
+    if (pid == 0)
+    {
+        setup_child(keep_fd);
+        ::execvpe(args[0], args.data(), envp);
+        ::_exit(127);
+    }
+
+    return pid;
+#endif
+}
+
+Prefork::~Prefork()
+{
+    cancel();
+}
+
+bool Prefork::fork(const std::vector<std::string>& argv, int keep_fd, const ChildEnvironment& env)
+{
+    cancel();
+    if (argv.empty())
+        return false;
+
+    std::vector<char*> args;
+    for (const auto& arg : argv)
+        args.push_back(const_cast<char*>(arg.c_str()));
+    args.push_back(nullptr);
+    char* const* envp = env.envp();
+    const pid_t parent = ::getpid();
+
+    const pid_t pid = ::fork();
+    if (pid < 0)
+    {
+        std::cerr << "fork: " << std::strerror(errno) << std::endl;
+        return false;
+    }
+
+    if (pid == 0)
+    {
+        // a stopped child is not left behind by a launcher which died
+        ::prctl(PR_SET_PDEATHSIG, SIGKILL);
+        if (::getppid() != parent)
+            ::_exit(127);
+        setup_child(keep_fd);
+        sigset_t mask;
+        sigemptyset(&mask);
+        ::sigprocmask(SIG_SETMASK, &mask, nullptr);
+        ::raise(SIGSTOP);
+        // committed, the application outlives the launcher
+        ::prctl(PR_SET_PDEATHSIG, 0);
+        ::execvpe(args[0], args.data(), envp);
+        ::_exit(127);
+    }
+
+    m_pid = pid;
+    m_argv = argv;
+    return true;
+}
+
+pid_t Prefork::commit()
+{
+    if (!pending())
+        return -1;
+
+    // a SIGCONT sent before the child stopped would be lost, the child is
+    // long stopped by the time a launch is confirmed
+    int status = 0;
+    if (::waitpid(m_pid, &status, WUNTRACED) != m_pid || !WIFSTOPPED(status))
+    {
+        m_pid = -1;
+        return -1;
+    }
+
+    ::kill(m_pid, SIGCONT);
+    const auto pid = m_pid;
+    m_pid = -1;
+    m_argv.clear();
+    return pid;
+}
+
+void Prefork::cancel()
+{
+    if (!pending())
+        return;
+
+    ::kill(m_pid, SIGKILL);
+    ::waitpid(m_pid, nullptr, 0);
+    m_pid = -1;
+    m_argv.clear();
+}
+
+bool split_command(const std::string& cmd, std::vector<std::string>& argv)
+{
+    argv.clear();
+
+    std::vector<std::string> words;
+    std::string word;
+    bool in_word = false;
+    for (size_t i = 0; i < cmd.size(); ++i)
+    {
+        const char c = cmd[i];
+        switch (c)
+        {
+        case ' ':
+        case '\t':
+        case '\n':
+            if (in_word)
+                words.push_back(std::move(word));
+            word.clear();
+            in_word = false;
+            break;
+        case '\'':
+        {
+            const auto end = cmd.find('\'', i + 1);
+            if (end == std::string::npos)
+                return false;
+            word.append(cmd, i + 1, end - i - 1);
+            i = end;
+            in_word = true;
+            break;
+        }
+        case '"':
+        {
+            for (++i; i < cmd.size() && cmd[i] != '"'; ++i)
+            {
+                if (cmd[i] == '\\' && i + 1 < cmd.size() && std::strchr("$`\"\\\n", cmd[i + 1]))
+                {
+                    if (cmd[++i] == '\n')
+                        continue;
+                }
+                else if (cmd[i] == '$' || cmd[i] == '`')
+                    return false;
+                word += cmd[i];
+            }
+            if (i >= cmd.size())
+                return false;
+            in_word = true;
+            break;
+        }
+        case '\\':
+            if (++i >= cmd.size())
+                return false;
+            // an escaped newline joins two lines
+            if (cmd[i] != '\n')
+            {
+                word += cmd[i];
+                in_word = true;
+            }
+            break;
+        default:
+            if (std::strchr("|&;<>()$`*?[{}!", c))
+                return false;
+            // comments and home directories, at the start of a word
+            if (!in_word && (c == '#' || c == '~'))
+                return false;
+            // a variable assigned for the command
+            if (c == '=' && words.empty())
+                return false;
+            word += c;
+            in_word = true;
+            break;
+        }
+    }
+
+    if (in_word)
+        words.push_back(std::move(word));
+
+    argv = std::move(words);
+    return !argv.empty();
+}
+
+ChildWatch::ChildWatch(asio::io_context& io)
+    : m_pidfd(io),
+      m_timer(io),
+      m_kill_timer(io)
+{}
+
+ChildWatch::~ChildWatch()
+{
+    asio::error_code ec;
+    m_pidfd.close(ec);
+    m_timer.cancel();
+    m_kill_timer.cancel();
+}
+
+bool ChildWatch::spawn(const std::string& cmd, ExitCallback callback, int keep_fd,
+                       const ChildEnvironment& env)
+{
+    if (running())
+        return false;
+
+    // everything the child needs is prepared before fork()
+    const char* argv[] = {"sh", "-c", cmd.c_str(), nullptr};
+    char* const* envp = env.envp();
+
+    const pid_t pid = ::fork();
+    if (pid < 0)
+    {
+        std::cerr << "fork: " << std::strerror(errno) << std::endl;
+        return false;
+    }
+
+    if (pid == 0)
+    {
+        setup_child(keep_fd);
+        ::execve("/bin/sh", const_cast<char* const*>(argv), envp);
+        ::_exit(127);
+    }
+
+    return watch(pid, std::move(callback));
+}
+
+bool ChildWatch::spawn(const std::vector<std::string>& argv, ExitCallback callback, int keep_fd,
+                       const ChildEnvironment& env)
+{
+    if (running())
+        return false;
+
+    const pid_t pid = spawn_process(argv, keep_fd, env);
+    if (pid < 0)
+        return false;
+
+    return watch(pid, std::move(callback));
+}
+
+bool ChildWatch::watch(pid_t pid, ExitCallback callback)
+{
+    if (running())
+        return false;
+
+    m_pid = pid;
+    m_callback = std::move(callback);
+    wait();
+    return true;
+}
+
+void ChildWatch::terminate(std::chrono::milliseconds grace)
+{
+    if (!running())
+        return;
+
+    // the child is not reaped before the exit callback, so its pid is not reused
+    ::kill(-m_pid, SIGTERM);
+
+    m_kill_timer.expires_after(grace);
+    m_kill_timer.async_wait([this, pid = m_pid](const asio::error_code & ec)
+    {
+        if (!ec && m_pid == pid)
+            ::kill(-pid, SIGKILL);
+    });
+}
+
+void ChildWatch::wait()
+{
+    const int fd = pidfd_open(m_pid);
+    if (fd < 0)
+    {
+        poll();
+        return;
+    }
+
+    m_pidfd.assign(fd);
+    m_pidfd.async_wait(asio::posix::stream_descriptor::wait_read,
+                       [this](const asio::error_code & ec)
+    {
+        if (ec)
+            return;
+
+        asio::error_code ignored;
+        m_pidfd.close(ignored);
+        reap();
+    });
+}
+
+void ChildWatch::poll()
+{
+    m_timer.expires_after(std::chrono::milliseconds(100));
+    m_timer.async_wait([this](const asio::error_code & ec)
+    {
+        if (ec)
+            return;
+
+        int status = 0;
+        if (::waitpid(m_pid, &status, WNOHANG) == 0)
+        {
+            poll();
+            return;
+        }
+
+        m_pid = -1;
+        m_kill_timer.cancel();
+        auto callback = std::move(m_callback);
+        callback(status);
+    });
+}
+
+void ChildWatch::reap()
+{
+    int status = 0;
+    ::waitpid(m_pid, &status, 0);
+    m_pid = -1;
+    m_kill_timer.cancel();
+
+    auto callback = std::move(m_callback);
+    callback(status);
+}
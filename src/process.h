@@ -0,0 +1,206 @@
+/*
+ * Copyright (C) 2026 Microchip Technology Inc.  All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#ifndef EGT_LAUNCHER_PROCESS_H
+#define EGT_LAUNCHER_PROCESS_H
+
+#include <chrono>
+#include <cstdint>
+#include <egt/asio.hpp>
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <sys/types.h>
+#include <vector>
+
+/**
+ * Environment of a child: the one of the launcher, with some variables set.
+ *
+ * The environment of the launcher itself is never changed once it runs
+ * threads, as setenv() may reallocate it under a getenv() of another one.
+ */
+class ChildEnvironment
+{
+public:
+
+    /**
+     * Set a variable, replacing an inherited one.
+     */
+    void set(const std::string& name, const std::string& value);
+
+    /**
+     * Null-terminated array of "NAME=value" for execve(), valid until the
+     * next call or change.
+     */
+    char* const* envp() const;
+
+    /**
+     * Assignments for a shell command line, like "NAME='value' ", to be put
+     * before the command they apply to.
+     */
+    std::string assignments() const;
+
+private:
+
+    std::map<std::string, std::string> m_vars;
+    mutable std::vector<std::string> m_strings;
+    mutable std::vector<char*> m_envp;
+};
+
+/**
+ * Spawn a shell command and get notified on the UI thread when it exits.
+ *
+ * The exit is watched with a pidfd from the io_context, or by polling
+ * waitpid() on kernels without pidfd_open().
+ */
+class ChildWatch
+{
+public:
+
+    /**
+     * Invoked with the wait status of the child.
+     */
+    using ExitCallback = std::function<void(int status)>;
+
+    explicit ChildWatch(asio::io_context& io);
+
+    ChildWatch(const ChildWatch&) = delete;
+    ChildWatch& operator=(const ChildWatch&) = delete;
+
+    ~ChildWatch();
+
+    /**
+     * Run cmd with /bin/sh -c, with stdin closed and stdout/stderr on
+     * /dev/null, like launch.sh does.
+     *
+     * keep_fd, if not -1, is left open in the child.
+     */
+    bool spawn(const std::string& cmd, ExitCallback callback, int keep_fd = -1,
+               const ChildEnvironment& env = {});
+
+    /**
+     * Run argv directly, see spawn_process().
+     */
+    bool spawn(const std::vector<std::string>& argv, ExitCallback callback, int keep_fd = -1,
+               const ChildEnvironment& env = {});
+
+    /**
+     * Watch a child spawned otherwise, which must not be waited for elsewhere.
+     */
+    bool watch(pid_t pid, ExitCallback callback);
+
+    /**
+     * End the child and its session with SIGTERM, then with SIGKILL if it
+     * has not exited after grace.
+     */
+    void terminate(std::chrono::milliseconds grace);
+
+    bool running() const { return m_pid > 0; }
+
+    pid_t pid() const { return m_pid; }
+
+private:
+
+    void wait();
+
+    void poll();
+
+    void reap();
+
+    pid_t m_pid{-1};
+    asio::posix::stream_descriptor m_pidfd;
+    asio::steady_timer m_timer;
+    asio::steady_timer m_kill_timer;
+    ExitCallback m_callback;
+};
+
+/**
+ * A child forked ahead of a launch, stopped before executing its command
+ * until the launch is confirmed.
+ *
+ * This takes the fork of the launcher, with its page tables, out of the
+ * time to start the application.
+ */
+class Prefork
+{
+public:
+
+    Prefork() = default;
+
+    Prefork(const Prefork&) = delete;
+    Prefork& operator=(const Prefork&) = delete;
+
+    ~Prefork();
+
+    /**
+     * Fork a child which stops, then runs argv like spawn_process() once
+     * committed. keep_fd, if not -1, is left open in the child.
+     */
+    bool fork(const std::vector<std::string>& argv, int keep_fd = -1,
+              const ChildEnvironment& env = {});
+
+    /**
+     * Let the child run its command, returns its pid, or -1 if none.
+     */
+    pid_t commit();
+
+    /**
+     * Kill and reap the child, if any.
+     */
+    void cancel();
+
+    bool pending() const { return m_pid > 0; }
+
+    const std::vector<std::string>& argv() const { return m_argv; }
+
+private:
+
+    pid_t m_pid{-1};
+    std::vector<std::string> m_argv;
+};
+
+/**
+ * Quote a word for /bin/sh, in single quotes.
+ */
+std::string shell_quote(const std::string& word);
+
+/**
+ * Run argv, looked up in PATH, without a shell.
+ *
+ * Like launch.sh does, stdin is closed, stdout and stderr are on /dev/null
+ * and the child gets its own session. keep_fd, if not -1, is left open in
+ * the child. Returns the pid, or -1 if argv cannot be executed.
+ */
+pid_t spawn_process(const std::vector<std::string>& argv, int keep_fd = -1,
+                    const ChildEnvironment& env = {});
+
+/**
+ * Split a command line into words, the way /bin/sh would.
+ *
+ * Quotes and backslashes are supported. Returns false, with argv empty, if
+ * the command needs a shell for expansions, redirections or several
+ * commands.
+ */
+bool split_command(const std::string& cmd, std::vector<std::string>& argv);
+
+/**
+ * Resident set size of this process in bytes, 0 if unknown.
+ */
+uint64_t resident_memory();
+
+/**
+ * Open a pidfd, returns -1 if unsupported by the kernel.
+ */
+int pidfd_open(pid_t pid);
+
+/**
+ * Close every file descriptor above stderr but keep_fd, in a forked child.
+ *
+ * Only async-signal-safe functions are used.
+ */
+void close_inherited_fds(int keep_fd = -1);
+
+#endif
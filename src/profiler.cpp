@@ -0,0 +1,132 @@
+/*
+ * Copyright (C) 2026 Microchip Technology Inc.  All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "profiler.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+static int64_t to_us(Profiler::Clock::duration d)
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(d).count();
+}
+
+Profiler::Profiler(std::string output, Clock::time_point origin)
+    : m_output(std::move(output)),
+      m_enabled(!m_output.empty()),
+      m_origin(origin)
+{}
+
+void Profiler::begin(const char* name)
+{
+    // later phases, like reloads, are not part of the startup
+    if (!enabled() || m_reported)
+        return;
+
+    m_phases.push_back({name, Clock::now(), {}, true});
+}
+
+void Profiler::end(const char* name)
+{
+    if (!enabled() || m_reported)
+        return;
+
+    const auto now = Clock::now();
+    auto phase = std::find_if(m_phases.rbegin(), m_phases.rend(), [name](const Phase & p)
+    {
+        return p.running && std::strcmp(p.name, name) == 0;
+    });
+    if (phase == m_phases.rend())
+        return;
+
+    phase->duration = now - phase->start;
+    phase->running = false;
+}
+
+bool Profiler::running(const char* name) const
+{
+    if (m_reported)
+        return false;
+
+    return std::any_of(m_phases.begin(), m_phases.end(), [name](const Phase & p)
+    {
+        return p.running && std::strcmp(p.name, name) == 0;
+    });
+}
+
+Profiler::Clock::duration Profiler::total(const char* name) const
+{
+    Clock::duration sum{};
+    for (auto& phase : m_phases)
+    {
+        if (!phase.running && std::strcmp(phase.name, name) == 0)
+            sum += phase.duration;
+    }
+    return sum;
+}
+
+std::vector<const char*> Profiler::phases() const
+{
+    std::vector<const char*> names;
+    for (auto& phase : m_phases)
+    {
+        auto same = [&phase](const char* name) { return std::strcmp(name, phase.name) == 0; };
+        if (std::none_of(names.begin(), names.end(), same))
+            names.push_back(phase.name);
+    }
+    return names;
+}
+
+bool Profiler::report()
+{
+    if (m_reported)
+        return false;
+    m_reported = true;
+
+    if (m_output.empty())
+        return false;
+
+    std::ostringstream out;
+    out << "{\n"
+        << "  \"clock\": \"monotonic\",\n"
+        << "  \"origin_us\": " << to_us(m_origin.time_since_epoch()) << ",\n"
+        << "  \"phases\": [";
+
+    const char* separator = "\n";
+    for (auto& phase : m_phases)
+    {
+        if (phase.running)
+            continue;
+
+        out << separator
+            << "    { \"name\": \"" << phase.name << "\", "
+            << "\"start_us\": " << to_us(phase.start - m_origin) << ", "
+            << "\"duration_us\": " << to_us(phase.duration) << " }";
+        separator = ",\n";
+    }
+    out << "\n  ]\n}\n";
+
+    if (m_output == "-")
+    {
+        std::cerr << out.str();
+        return true;
+    }
+
+    std::ofstream file(m_output, std::ios::trunc);
+    file << out.str();
+    if (!file.good())
+    {
+        std::cerr << "cannot write profile " << m_output << std::endl;
+        return false;
+    }
+
+    return true;
+}
@@ -0,0 +1,121 @@
+/*
+ * Copyright (C) 2026 Microchip Technology Inc.  All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#ifndef EGT_LAUNCHER_PROFILER_H
+#define EGT_LAUNCHER_PROFILER_H
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+/**
+ * Timing of the startup phases of the launcher.
+ *
+ * Each phase is recorded with its start, relative to the origin given at
+ * construction, and its duration, both read from the monotonic clock. The
+ * same phase may be recorded several times, once per directory for example.
+ * The report is written as JSON once startup is over.
+ *
+ * Phases must be recorded from the UI thread.
+ */
+class Profiler
+{
+public:
+
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * Record a phase for the lifetime of the object.
+     */
+    class Scope
+    {
+    public:
+
+        Scope(Profiler& profiler, const char* name)
+            : m_profiler(profiler),
+              m_name(name)
+        {
+            m_profiler.begin(m_name);
+        }
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+        ~Scope()
+        {
+            m_profiler.end(m_name);
+        }
+
+    private:
+        Profiler& m_profiler;
+        const char* m_name;
+    };
+
+    /**
+     * @param output File the report is written to, "-" for stderr, empty to
+     *        disable profiling.
+     * @param origin Time all the phases are relative to.
+     */
+    Profiler(std::string output, Clock::time_point origin);
+
+    bool enabled() const { return m_enabled; }
+
+    /**
+     * Record phases even without an output, to read them with total().
+     */
+    void enable() { m_enabled = true; }
+
+    /**
+     * Start a phase, name must be a string literal.
+     */
+    void begin(const char* name);
+
+    /**
+     * End the last started phase of that name, if any.
+     */
+    void end(const char* name);
+
+    /**
+     * Tell if a phase of that name is started and not ended yet.
+     */
+    bool running(const char* name) const;
+
+    /**
+     * Sum of the durations of all the ended phases of that name.
+     */
+    Clock::duration total(const char* name) const;
+
+    /**
+     * Names of the recorded phases, in the order they were first started.
+     */
+    std::vector<const char*> phases() const;
+
+    /**
+     * Write the report, if there is an output. Phases not ended yet are
+     * left out.
+     *
+     * Only the first call writes anything, and no phase is recorded
+     * afterwards, even without an output.
+     */
+    bool report();
+
+private:
+
+    struct Phase
+    {
+        const char* name;
+        Clock::time_point start;
+        Clock::duration duration;
+        bool running;
+    };
+
+    std::string m_output;
+    bool m_enabled;
+    Clock::time_point m_origin;
+    std::vector<Phase> m_phases;
+    bool m_reported{false};
+};
+
+#endif
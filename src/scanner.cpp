@@ -0,0 +1,281 @@
+/*
+ * Copyright (C) 2026 Microchip Technology Inc.  All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "parallel.h"
+#include "scanner.h"
+#include <algorithm>
+#include <array>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <dirent.h>
+#include <fcntl.h>
+#include <fnmatch.h>
+#include <iostream>
+#include <mutex>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <thread>
+#include <unistd.h>
+
+namespace
+{
+
+/// Past this many queued directories, workers walk subdirectories inline.
+const size_t MAX_QUEUED_DIRS = 64;
+
+class Scanner
+{
+public:
+
+    Scanner(const ScanOptions& options, unsigned jobs, std::vector<std::string>* dirs)
+        : m_options(options),
+          m_jobs(jobs),
+          m_dirs(dirs)
+    {}
+
+    void run(const std::string& root)
+    {
+        auto path = root;
+        while (path.size() > 1 && path.back() == '/')
+            path.pop_back();
+
+        const int fd = ::openat(AT_FDCWD, path.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+        if (fd < 0)
+        {
+            if (errno != ENOENT && errno != ENOTDIR)
+                std::cerr << "error accessing: " << path << " :: " << std::strerror(errno) << std::endl;
+            return;
+        }
+
+        if (m_jobs <= 1)
+        {
+            walk(fd, path, 0);
+            return;
+        }
+
+        m_queue.push_back({fd, path, 0});
+
+        std::vector<std::thread> threads;
+        for (unsigned t = 1; t < m_jobs; ++t)
+            threads.emplace_back(&Scanner::worker, this);
+        worker();
+        for (auto& thread : threads)
+            thread.join();
+    }
+
+    std::vector<std::string>& files() { return m_files; }
+    ScanStats& stats() { return m_stats; }
+
+private:
+
+    struct Dir
+    {
+        int fd;
+        std::string path;
+        int depth;
+    };
+
+    void worker()
+    {
+        while (true)
+        {
+            Dir dir;
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_cond.wait(lock, [this]() { return !m_queue.empty() || !m_active; });
+                if (m_queue.empty())
+                    return;
+                dir = std::move(m_queue.front());
+                m_queue.pop_front();
+                ++m_active;
+            }
+
+            walk(dir.fd, dir.path, dir.depth);
+
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                --m_active;
+            }
+            m_cond.notify_all();
+        }
+    }
+
+    static std::string join(const std::string& dir, const std::string& name)
+    {
+        if (dir == "/")
+            return dir + name;
+
+        return dir + "/" + name;
+    }
+
+    bool matches(const char* name) const
+    {
+        const auto len = std::strlen(name);
+        const auto& suffix = m_options.suffix;
+        return len >= suffix.size() &&
+               std::memcmp(name + len - suffix.size(), suffix.data(), suffix.size()) == 0;
+    }
+
+    bool pruned(const char* name) const
+    {
+        return std::any_of(m_options.prune.begin(), m_options.prune.end(),
+                           [name](const std::string & pattern)
+        {
+            return ::fnmatch(pattern.c_str(), name, 0) == 0;
+        });
+    }
+
+    /**
+     * Read a directory, taking ownership of fd.
+     */
+    void walk(int fd, const std::string& path, int depth)
+    {
+        std::vector<std::string> files;
+        std::vector<std::string> dirs;
+        size_t scanned = 0;
+        bool ignored = false;
+
+        alignas(struct dirent64) std::array<char, 16 * 1024> buffer{};
+        while (!ignored)
+        {
+            const auto n = ::syscall(SYS_getdents64, fd, buffer.data(), buffer.size());
+            if (n < 0)
+            {
+                std::cerr << "error accessing: " << path << " :: " << std::strerror(errno) << std::endl;
+                break;
+            }
+            if (n == 0)
+                break;
+
+            for (long pos = 0; pos < n;)
+            {
+                // glibc's dirent64 has the layout of the kernel's linux_dirent64
+                const auto* d = reinterpret_cast<const struct dirent64*>(buffer.data() + pos);
+                pos += d->d_reclen;
+
+                const char* name = d->d_name;
+                if (name[0] == '.' && (!name[1] || (name[1] == '.' && !name[2])))
+                    continue;
+
+                ++scanned;
+
+                if (!m_options.ignore_file.empty() && m_options.ignore_file == name)
+                {
+                    ignored = true;
+                    break;
+                }
+
+                auto type = d->d_type;
+                if (type == DT_UNKNOWN || type == DT_LNK)
+                {
+                    // follows links, like the std::filesystem::is_directory() check it replaces
+                    struct stat st {};
+                    if (::fstatat(fd, name, &st, 0) < 0)
+                        continue;
+                    if (S_ISDIR(st.st_mode))
+                        type = (type == DT_LNK) ? DT_LNK : DT_DIR;
+                    else
+                        type = DT_REG;
+                }
+
+                if (type == DT_DIR)
+                    dirs.emplace_back(name);
+                else if (type != DT_LNK && matches(name))
+                    files.push_back(join(path, name));
+            }
+        }
+
+        if (ignored)
+        {
+            files.clear();
+            dirs.clear();
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stats.dirs++;
+            m_stats.scanned += scanned;
+            if (m_dirs && !ignored)
+                m_dirs->push_back(path);
+            m_stats.matched += files.size();
+            m_files.insert(m_files.end(),
+                           std::make_move_iterator(files.begin()),
+                           std::make_move_iterator(files.end()));
+        }
+
+        if (m_options.max_depth < 0 || depth < m_options.max_depth)
+        {
+            for (auto& name : dirs)
+            {
+                if (pruned(name.c_str()))
+                    continue;
+
+                const int child = ::openat(fd, name.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+                if (child < 0)
+                {
+                    std::cerr << "error accessing: " << path << "/" << name << " :: " <<
+                              std::strerror(errno) << std::endl;
+                    continue;
+                }
+
+                auto child_path = join(path, name);
+
+                if (m_jobs > 1)
+                {
+                    std::unique_lock<std::mutex> lock(m_mutex);
+                    if (m_queue.size() < MAX_QUEUED_DIRS)
+                    {
+                        m_queue.push_back({child, std::move(child_path), depth + 1});
+                        lock.unlock();
+                        m_cond.notify_one();
+                        continue;
+                    }
+                }
+
+                walk(child, child_path, depth + 1);
+            }
+        }
+
+        ::close(fd);
+    }
+
+    const ScanOptions& m_options;
+    unsigned m_jobs;
+    std::vector<std::string>* m_dirs;
+    std::vector<std::string> m_files;
+    ScanStats m_stats;
+    std::mutex m_mutex;
+    std::condition_variable m_cond;
+    std::deque<Dir> m_queue;
+    unsigned m_active{0};
+};
+
+}
+
+std::vector<std::string> scan_files(const std::string& root, const ScanOptions& options,
+                                    unsigned jobs, ScanStats& stats,
+                                    std::vector<std::string>* dirs)
+{
+    const auto start = std::chrono::steady_clock::now();
+
+    Scanner scanner(options, resolve_jobs(jobs), dirs);
+    scanner.run(root);
+
+    auto files = std::move(scanner.files());
+
+    // give some determinism to the order of results
+    std::sort(files.begin(), files.end());
+
+    stats = scanner.stats();
+    stats.elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+                        std::chrono::steady_clock::now() - start);
+
+    return files;
+}
@@ -0,0 +1,59 @@
+/*
+ * Copyright (C) 2026 Microchip Technology Inc.  All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#ifndef EGT_LAUNCHER_SCANNER_H
+#define EGT_LAUNCHER_SCANNER_H
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+/**
+ * Tuning of the manifest directory scan.
+ */
+struct ScanOptions
+{
+    /// File name suffix to match.
+    std::string suffix{".xml"};
+    /// Maximum depth below the root, negative for no limit.
+    int max_depth{-1};
+    /// fnmatch(3) patterns of directory names which are not entered.
+    std::vector<std::string> prune;
+    /// A directory containing a file with this name is skipped with its subtree.
+    std::string ignore_file{".egt-launcher-ignore"};
+};
+
+/**
+ * Counters of a scan.
+ */
+struct ScanStats
+{
+    /// Directories read.
+    size_t dirs{0};
+    /// Directory entries examined.
+    size_t scanned{0};
+    /// Files matching the suffix.
+    size_t matched{0};
+    /// Wall clock time of the scan.
+    std::chrono::microseconds elapsed{0};
+};
+
+/**
+ * Recursively find the files below root matching the scan options.
+ *
+ * Directories are read with openat() and getdents64() directly, so entries
+ * are classified from d_type without a stat() in the common case. With more
+ * than one job, subdirectories are handed out to a pool of threads.
+ *
+ * Symbolic links to files are matched, but links to directories are not
+ * followed. The result is sorted.
+ *
+ * If dirs is not null, the directories read are appended to it.
+ */
+std::vector<std::string> scan_files(const std::string& root, const ScanOptions& options,
+                                    unsigned jobs, ScanStats& stats,
+                                    std::vector<std::string>* dirs = nullptr);
+
+#endif
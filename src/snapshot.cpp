@@ -0,0 +1,157 @@
+/*
+ * Copyright (C) 2026 Microchip Technology Inc.  All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "snapshot.h"
+#include <iostream>
+
+namespace
+{
+
+const uint32_t SNAPSHOT_MAGIC = 0x534c4745;
+const uint32_t SNAPSHOT_VERSION = 1;
+
+/// Alignment of the pixels in the file.
+const size_t SNAPSHOT_ALIGN = 64;
+
+/**
+ * FNV-1a hash of the sources and their stamps.
+ */
+class SourceHash
+{
+public:
+
+    void add(const std::string& path, const FileStamp& stamp)
+    {
+        bytes(path.data(), path.size() + 1);
+        bytes(&stamp.mtime, sizeof(stamp.mtime));
+        bytes(&stamp.size, sizeof(stamp.size));
+    }
+
+    uint64_t value() const { return m_value; }
+
+private:
+
+    void bytes(const void* data, size_t len)
+    {
+        const auto* p = static_cast<const unsigned char*>(data);
+        for (size_t i = 0; i < len; ++i)
+        {
+            m_value ^= p[i];
+            m_value *= 0x100000001b3ULL;
+        }
+    }
+
+    uint64_t m_value{0xcbf29ce484222325ULL};
+};
+
+}
+
+Snapshot::Snapshot(std::string path)
+    : m_path(std::move(path))
+{}
+
+IconSurface Snapshot::open(int width, int height, size_t page) const
+{
+    auto mapping = MappedFile::open(m_path);
+    if (!mapping)
+        return nullptr;
+
+    const auto stride = cairo_format_stride_for_width(CAIRO_FORMAT_ARGB32, width);
+
+    CacheReader in(reinterpret_cast<const char*>(mapping->data()), mapping->size());
+    if (in.u32() != SNAPSHOT_MAGIC || in.u32() != SNAPSHOT_VERSION)
+        return nullptr;
+
+    if (in.u32() != static_cast<uint32_t>(CAIRO_FORMAT_ARGB32) ||
+        in.u32() != static_cast<uint32_t>(width) ||
+        in.u32() != static_cast<uint32_t>(height) ||
+        in.u32() != static_cast<uint32_t>(stride) ||
+        in.u64() != page)
+        return nullptr;
+
+    const auto hash = in.u64();
+
+    // no scan here, the sources recorded with the frame are stat'ed instead
+    SourceHash current;
+    const auto count = in.u32();
+    for (uint32_t i = 0; i < count && in.ok(); ++i)
+    {
+        const auto path = in.str();
+        FileStamp stamp;
+        if (!file_stamp(path, stamp))
+            return nullptr;
+        current.add(path, stamp);
+    }
+
+    const auto offset = in.u64();
+    const auto frame_size = static_cast<size_t>(stride) * height;
+    if (!in.ok() || current.value() != hash || offset % SNAPSHOT_ALIGN ||
+        offset > mapping->size() || frame_size > mapping->size() - offset)
+        return nullptr;
+
+    auto* surface = cairo_image_surface_create_for_data(mapping->data() + offset,
+                    CAIRO_FORMAT_ARGB32, width, height, stride);
+
+    // the mapping must outlive the surface pointing into it
+    return IconSurface(surface, [mapping](cairo_surface_t * s)
+    {
+        cairo_surface_destroy(s);
+    });
+}
+
+bool Snapshot::save(const IconSurface& frame, size_t page, const std::vector<Source>& sources) const
+{
+    if (m_path.empty() || !frame ||
+        cairo_image_surface_get_format(frame.get()) != CAIRO_FORMAT_ARGB32)
+        return false;
+
+    cairo_surface_flush(frame.get());
+    const auto width = cairo_image_surface_get_width(frame.get());
+    const auto height = cairo_image_surface_get_height(frame.get());
+    const auto stride = cairo_image_surface_get_stride(frame.get());
+    const auto* pixels = cairo_image_surface_get_data(frame.get());
+    const auto file_stride = cairo_format_stride_for_width(CAIRO_FORMAT_ARGB32, width);
+
+    SourceHash hash;
+    for (auto& source : sources)
+        hash.add(source.first, source.second);
+
+    CacheWriter out;
+    out.u32(SNAPSHOT_MAGIC);
+    out.u32(SNAPSHOT_VERSION);
+    out.u32(static_cast<uint32_t>(CAIRO_FORMAT_ARGB32));
+    out.u32(width);
+    out.u32(height);
+    out.u32(file_stride);
+    out.u64(page);
+    out.u64(hash.value());
+    out.u32(sources.size());
+    for (auto& source : sources)
+        out.str(source.first);
+
+    const auto offset = (out.data().size() + sizeof(uint64_t) + SNAPSHOT_ALIGN - 1) &
+                        ~(SNAPSHOT_ALIGN - 1);
+    out.u64(offset);
+
+    std::string data = out.data();
+    data.resize(offset, '\0');
+    for (int y = 0; y < height; ++y)
+    {
+        data.append(reinterpret_cast<const char*>(pixels) + static_cast<size_t>(y) * stride,
+                    file_stride);
+    }
+
+    if (!write_file_atomic(m_path, data))
+    {
+        std::cerr << "cannot write snapshot " << m_path << std::endl;
+        return false;
+    }
+
+    return true;
+}
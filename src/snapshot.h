@@ -0,0 +1,56 @@
+/*
+ * Copyright (C) 2026 Microchip Technology Inc.  All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#ifndef EGT_LAUNCHER_SNAPSHOT_H
+#define EGT_LAUNCHER_SNAPSHOT_H
+
+#include "cache.h"
+#include "iconloader.h"
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * Raw copy of the last frame composed by the launcher.
+ *
+ * The frame is shown at startup, before anything is decoded, scanned or laid
+ * out, and replaced by the live widget tree once it is ready. It is only
+ * used if it was taken on the same page, at the same size, and none of the
+ * manifests and directories it was built from changed since: their paths
+ * are recorded, and a hash of their stamps is checked against the current
+ * ones.
+ */
+class Snapshot
+{
+public:
+
+    /// A file the frame depends on, with its stamp when the frame was taken.
+    using Source = std::pair<std::string, FileStamp>;
+
+    /**
+     * @param path Snapshot file, empty to disable the snapshot.
+     */
+    explicit Snapshot(std::string path);
+
+    /**
+     * Map the snapshot, returns nullptr if missing, invalid or out of date.
+     *
+     * The pixels are not copied: the surface points into the mapping, which
+     * is released with the last reference to the surface.
+     */
+    IconSurface open(int width, int height, size_t page) const;
+
+    /**
+     * Replace the snapshot with frame, in CAIRO_FORMAT_ARGB32.
+     */
+    bool save(const IconSurface& frame, size_t page, const std::vector<Source>& sources) const;
+
+private:
+    std::string m_path;
+};
+
+#endif
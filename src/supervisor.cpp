@@ -0,0 +1,105 @@
+/*
+ * Copyright (C) 2026 Microchip Technology Inc.  All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "supervisor.h"
+#include <algorithm>
+#include <sys/wait.h>
+
+bool parse_restart_policy(const std::string& name, RestartPolicy& policy)
+{
+    if (name == "home")
+        policy = RestartPolicy::home;
+    else if (name == "restart")
+        policy = RestartPolicy::restart;
+    else if (name == "backoff")
+        policy = RestartPolicy::backoff;
+    else
+        return false;
+    return true;
+}
+
+const char* restart_policy_name(RestartPolicy policy)
+{
+    switch (policy)
+    {
+    case RestartPolicy::restart:
+        return "restart";
+    case RestartPolicy::backoff:
+        return "backoff";
+    default:
+        return "home";
+    }
+}
+
+void Supervisor::started(const std::string& exe, bool restart)
+{
+    auto& record = m_records[exe];
+    record.started = Clock::now();
+    if (!restart)
+    {
+        record.consecutive = 0;
+        record.recent.clear();
+    }
+}
+
+Supervisor::Decision Supervisor::exited(const std::string& exe, int status, bool requested,
+                                        RestartPolicy policy)
+{
+    const auto now = Clock::now();
+    auto& record = m_records[exe];
+    ++record.exits;
+    record.status = status;
+    record.runtime = now - record.started;
+
+    Decision decision;
+    const bool failed = !WIFEXITED(status) || WEXITSTATUS(status) != 0;
+    if (requested || !failed)
+    {
+        record.consecutive = 0;
+        return decision;
+    }
+
+    ++record.failures;
+    if (record.runtime >= STABLE_RUNTIME)
+        record.consecutive = 0;
+    ++record.consecutive;
+
+    while (!record.recent.empty() && now - record.recent.front() > CRASH_LOOP_WINDOW)
+        record.recent.pop_front();
+    record.recent.push_back(now);
+
+    if (policy == RestartPolicy::home)
+        return decision;
+
+    if (record.recent.size() > CRASH_LOOP_FAILURES)
+    {
+        ++record.given_up;
+        record.recent.clear();
+        decision.action = Action::give_up;
+        return decision;
+    }
+
+    if (policy == RestartPolicy::backoff)
+    {
+        // 500 ms, 1 s, 2 s... on failures in a row
+        const auto shift = std::min(record.consecutive - 1, 16U);
+        decision.delay = std::min<std::chrono::milliseconds>(BACKOFF_MIN * (1U << shift), BACKOFF_MAX);
+    }
+
+    ++record.restarts;
+    decision.action = Action::restart;
+    return decision;
+}
+
+std::string Supervisor::status_name(int status)
+{
+    if (WIFSIGNALED(status))
+        return "signal " + std::to_string(WTERMSIG(status));
+    return "exit " + std::to_string(WEXITSTATUS(status));
+}
@@ -0,0 +1,116 @@
+/*
+ * Copyright (C) 2026 Microchip Technology Inc.  All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#ifndef EGT_LAUNCHER_SUPERVISOR_H
+#define EGT_LAUNCHER_SUPERVISOR_H
+
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <string>
+
+/**
+ * What to do when an application fails, from <restart>.
+ */
+enum class RestartPolicy : uint8_t
+{
+    /// Show the launcher again.
+    home,
+    /// Start the application again right away.
+    restart,
+    /// Start the application again, waiting longer after each failure.
+    backoff,
+};
+
+/**
+ * Parse "home", "restart" or "backoff", returns false if unknown.
+ */
+bool parse_restart_policy(const std::string& name, RestartPolicy& policy);
+
+const char* restart_policy_name(RestartPolicy policy);
+
+/**
+ * Exit history of the launched applications, deciding whether to start them
+ * again.
+ *
+ * Only failures are restarted: an exit status of 0 or an exit requested
+ * with an exit key always returns home. Failures close to each other are a
+ * crash loop, which is given up until the application is launched again
+ * from the launcher.
+ */
+class Supervisor
+{
+public:
+
+    using Clock = std::chrono::steady_clock;
+
+    enum class Action
+    {
+        home,
+        restart,
+        give_up,
+    };
+
+    struct Decision
+    {
+        Action action{Action::home};
+        /// Time to wait before the restart.
+        std::chrono::milliseconds delay{0};
+    };
+
+    /**
+     * Exits of one application.
+     */
+    struct Record
+    {
+        uint64_t exits{0};
+        uint64_t failures{0};
+        uint64_t restarts{0};
+        uint64_t given_up{0};
+        /// Wait status of the last exit.
+        int status{0};
+        Clock::duration runtime{};
+        /// Failures in a row, each run shorter than STABLE_RUNTIME.
+        unsigned consecutive{0};
+        /// Times of the failures within CRASH_LOOP_WINDOW.
+        std::deque<Clock::time_point> recent;
+        Clock::time_point started;
+    };
+
+    /// More failures than this within CRASH_LOOP_WINDOW is a crash loop.
+    static const unsigned CRASH_LOOP_FAILURES = 5;
+    static constexpr std::chrono::seconds CRASH_LOOP_WINDOW{60};
+    /// A run at least this long clears the failures in a row.
+    static constexpr std::chrono::seconds STABLE_RUNTIME{30};
+    static constexpr std::chrono::milliseconds BACKOFF_MIN{500};
+    static constexpr std::chrono::milliseconds BACKOFF_MAX{30000};
+
+    /**
+     * Record a start of exe. A launch from the launcher, rather than a
+     * restart, forgets the past failures.
+     */
+    void started(const std::string& exe, bool restart);
+
+    /**
+     * Record an exit of exe with its wait status, and decide what follows.
+     *
+     * requested tells the exit was asked for, with an exit key.
+     */
+    Decision exited(const std::string& exe, int status, bool requested, RestartPolicy policy);
+
+    const std::map<std::string, Record>& records() const { return m_records; }
+
+    /**
+     * Describe a wait status, like "exit 1" or "signal 11".
+     */
+    static std::string status_name(int status);
+
+private:
+
+    std::map<std::string, Record> m_records;
+};
+
+#endif
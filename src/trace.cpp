@@ -0,0 +1,289 @@
+/*
+ * Copyright (C) 2026 Microchip Technology Inc.  All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "trace.h"
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cstdarg>
+#include <cstring>
+#include <fcntl.h>
+#include <iostream>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+/// Events are written to the file in chunks of about this size.
+static const size_t FLUSH_SIZE = 64 * 1024;
+
+static const char* const TRACE_MARKERS[] =
+{
+    "/sys/kernel/tracing/trace_marker",
+    "/sys/kernel/debug/tracing/trace_marker",
+};
+
+/**
+ * Replace %p in path by pid, or add pid before the extension if there is no
+ * %p, so that a relaunch does not overwrite the trace of the previous run.
+ */
+static std::string trace_path(const std::string& path, pid_t pid)
+{
+    const auto id = std::to_string(pid);
+
+    std::string expanded = path;
+    bool found = false;
+    for (auto i = expanded.find("%p"); i != std::string::npos; i = expanded.find("%p", i + id.size()))
+    {
+        expanded.replace(i, 2, id);
+        found = true;
+    }
+    if (found)
+        return expanded;
+
+    const auto slash = path.rfind('/');
+    const auto dot = path.rfind('.');
+    if (dot == std::string::npos || dot == 0 || (slash != std::string::npos && dot <= slash + 1))
+        return path + "." + id;
+
+    return path.substr(0, dot) + "." + id + path.substr(dot);
+}
+
+static int thread_id()
+{
+    static thread_local const int tid = static_cast<int>(::syscall(SYS_gettid));
+    return tid;
+}
+
+static std::string to_us(Tracer::Clock::time_point t)
+{
+    const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(t.time_since_epoch()).count();
+    std::array<char, 32> buffer{};
+    std::snprintf(buffer.data(), buffer.size(), "%lld.%03lld",
+                  static_cast<long long>(ns / 1000), static_cast<long long>(ns % 1000));
+    return buffer.data();
+}
+
+static std::string json_string(const std::string& value)
+{
+    std::string result("\"");
+    for (auto c : value)
+    {
+        switch (c)
+        {
+        case '"':
+            result += "\\\"";
+            break;
+        case '\\':
+            result += "\\\\";
+            break;
+        default:
+            if (static_cast<unsigned char>(c) < 0x20)
+            {
+                std::array<char, 8> escaped{};
+                std::snprintf(escaped.data(), escaped.size(), "\\u%04x", c);
+                result += escaped.data();
+            }
+            else
+            {
+                result += c;
+            }
+        }
+    }
+    result += '"';
+    return result;
+}
+
+Tracer& Tracer::instance()
+{
+    static Tracer tracer;
+    return tracer;
+}
+
+Tracer::~Tracer()
+{
+    close();
+}
+
+bool Tracer::open(const std::string& path, bool marker)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_enabled)
+        return false;
+
+    m_pid = ::getpid();
+
+    if (!path.empty())
+    {
+        const auto file = trace_path(path, m_pid);
+        m_file = std::fopen(file.c_str(), "we");
+        if (!m_file)
+        {
+            std::cerr << "cannot open trace " << file << ": " << std::strerror(errno) << std::endl;
+            return false;
+        }
+
+        m_buffer = "[\n";
+        m_first = true;
+        append("{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":" + std::to_string(m_pid) +
+               ",\"args\":{\"name\":\"egt-launcher\"}}");
+    }
+
+    if (marker)
+    {
+        for (const auto* file : TRACE_MARKERS)
+        {
+            m_marker = ::open(file, O_WRONLY | O_CLOEXEC);
+            if (m_marker >= 0)
+                break;
+        }
+
+        if (m_marker < 0)
+            std::cerr << "no trace_marker, kernel markers disabled" << std::endl;
+    }
+
+    m_enabled = m_file || m_marker >= 0;
+    return m_enabled;
+}
+
+void Tracer::close()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_enabled = false;
+
+    if (m_file)
+    {
+        m_buffer += "\n]\n";
+        flush();
+        std::fclose(m_file);
+        m_file = nullptr;
+    }
+
+    if (m_marker >= 0)
+    {
+        ::close(m_marker);
+        m_marker = -1;
+    }
+}
+
+Tracer::Clock::time_point Tracer::begin(const char* name)
+{
+    if (enabled())
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        marker("B|%d|%s", m_pid, name);
+    }
+
+    return Clock::now();
+}
+
+void Tracer::end(const char* name, const char* category, Clock::time_point start,
+                 const std::string& detail)
+{
+    if (!enabled())
+        return;
+
+    const auto now = Clock::now();
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    marker("E|%d", m_pid);
+
+    if (!m_file)
+        return;
+
+    const auto dur = std::chrono::duration_cast<std::chrono::nanoseconds>(now - start).count();
+    std::array<char, 32> duration{};
+    std::snprintf(duration.data(), duration.size(), "%lld.%03lld",
+                  static_cast<long long>(dur / 1000), static_cast<long long>(dur % 1000));
+
+    std::string event = "{\"name\":\"";
+    event += name;
+    event += "\",\"cat\":\"";
+    event += category;
+    event += "\",\"ph\":\"X\",\"ts\":" + to_us(start) + ",\"dur\":" + duration.data() +
+             ",\"pid\":" + std::to_string(m_pid) + ",\"tid\":" + std::to_string(thread_id());
+    if (!detail.empty())
+        event += ",\"args\":{\"detail\":" + json_string(detail) + "}";
+    event += "}";
+    append(event);
+}
+
+void Tracer::counter(const char* name, const char* category, int64_t value)
+{
+    if (!enabled())
+        return;
+
+    const auto now = Clock::now();
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    marker("C|%d|%s|%lld", m_pid, name, static_cast<long long>(value));
+
+    if (!m_file)
+        return;
+
+    std::string event = "{\"name\":\"";
+    event += name;
+    event += "\",\"cat\":\"";
+    event += category;
+    event += "\",\"ph\":\"C\",\"ts\":" + to_us(now) + ",\"pid\":" + std::to_string(m_pid) +
+             ",\"args\":{\"value\":" + std::to_string(value) + "}}";
+    append(event);
+}
+
+void Tracer::thread_name(const char* name)
+{
+    if (!enabled())
+        return;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!m_file)
+        return;
+
+    append("{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":" + std::to_string(m_pid) +
+           ",\"tid\":" + std::to_string(thread_id()) +
+           ",\"args\":{\"name\":" + json_string(name) + "}}");
+}
+
+void Tracer::append(const std::string& event)
+{
+    if (!m_first)
+        m_buffer += ",\n";
+    m_first = false;
+    m_buffer += event;
+
+    if (m_buffer.size() >= FLUSH_SIZE)
+        flush();
+}
+
+void Tracer::flush()
+{
+    if (m_buffer.empty())
+        return;
+
+    if (std::fwrite(m_buffer.data(), 1, m_buffer.size(), m_file) != m_buffer.size())
+        std::cerr << "cannot write trace: " << std::strerror(errno) << std::endl;
+    std::fflush(m_file);
+    m_buffer.clear();
+}
+
+void Tracer::marker(const char* format, ...)
+{
+    if (m_marker < 0)
+        return;
+
+    std::array<char, 256> buffer{};
+    va_list args;
+    va_start(args, format);
+    const auto len = std::vsnprintf(buffer.data(), buffer.size(), format, args);
+    va_end(args);
+    if (len <= 0)
+        return;
+
+    // one write() per marker, which the kernel keeps whole, failures are ignored
+    const auto written = ::write(m_marker, buffer.data(), std::min<size_t>(len, buffer.size() - 1));
+    (void)written;
+}
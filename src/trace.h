@@ -0,0 +1,139 @@
+/*
+ * Copyright (C) 2026 Microchip Technology Inc.  All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#ifndef EGT_LAUNCHER_TRACE_H
+#define EGT_LAUNCHER_TRACE_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <string>
+
+/**
+ * Trace of the launcher activity in the Chrome trace event JSON format,
+ * which Perfetto and chrome://tracing load.
+ *
+ * Time stamps are read from the monotonic clock, like the kernel trace
+ * clock, so the trace can be lined up with a kernel trace. The same events
+ * can be mirrored to the ftrace trace_marker, where Perfetto shows them as
+ * slices and counters next to the scheduling and I/O events.
+ *
+ * Events may be emitted from any thread. While tracing is disabled, an
+ * event costs one atomic load.
+ */
+class Tracer
+{
+public:
+
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * Record a slice for the lifetime of the object.
+     */
+    class Scope
+    {
+    public:
+
+        /**
+         * name and category must be string literals, detail is copied only
+         * when tracing is enabled.
+         */
+        Scope(const char* name, const char* category, const std::string& detail = {})
+        {
+            auto& tracer = Tracer::instance();
+            if (!tracer.enabled())
+                return;
+
+            m_name = name;
+            m_category = category;
+            m_detail = detail;
+            m_start = tracer.begin(m_name);
+        }
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+        ~Scope()
+        {
+            if (m_name)
+                Tracer::instance().end(m_name, m_category, m_start, m_detail);
+        }
+
+    private:
+        const char* m_name{nullptr};
+        const char* m_category{nullptr};
+        std::string m_detail;
+        Clock::time_point m_start;
+    };
+
+    static Tracer& instance();
+
+    Tracer(const Tracer&) = delete;
+    Tracer& operator=(const Tracer&) = delete;
+
+    ~Tracer();
+
+    /**
+     * Start tracing.
+     *
+     * @param path JSON file to write, empty for none. %p is replaced by the
+     *             pid, which is added before the extension without %p.
+     * @param marker Mirror the events to the ftrace trace_marker.
+     */
+    bool open(const std::string& path, bool marker);
+
+    /**
+     * Terminate and close the JSON file, nothing is traced afterwards.
+     */
+    void close();
+
+    bool enabled() const { return m_enabled.load(std::memory_order_relaxed); }
+
+    /**
+     * Start a slice on the calling thread, returns its start time.
+     */
+    Clock::time_point begin(const char* name);
+
+    /**
+     * End the last slice started on the calling thread.
+     */
+    void end(const char* name, const char* category, Clock::time_point start,
+             const std::string& detail = {});
+
+    /**
+     * Record the value of a counter, like an animated position.
+     */
+    void counter(const char* name, const char* category, int64_t value);
+
+    /**
+     * Name the calling thread in the trace.
+     */
+    void thread_name(const char* name);
+
+private:
+
+    Tracer() = default;
+
+    /**
+     * Append an event, the caller holds m_mutex.
+     */
+    void append(const std::string& event);
+
+    void flush();
+
+    void marker(const char* format, ...) __attribute__((format(printf, 2, 3)));
+
+    std::atomic<bool> m_enabled{false};
+    std::mutex m_mutex;
+    FILE* m_file{nullptr};
+    int m_marker{-1};
+    int m_pid{0};
+    std::string m_buffer;
+    bool m_first{true};
+};
+
+#endif
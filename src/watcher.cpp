@@ -0,0 +1,139 @@
+/*
+ * Copyright (C) 2026 Microchip Technology Inc.  All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "watcher.h"
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <sys/inotify.h>
+
+static const uint32_t WATCH_MASK = IN_CLOSE_WRITE | IN_MOVED_TO | IN_MOVED_FROM |
+                                   IN_DELETE | IN_CREATE | IN_ATTRIB | IN_DELETE_SELF |
+                                   IN_MOVE_SELF | IN_ONLYDIR;
+
+Watcher::Watcher(asio::io_context& io, std::string suffix,
+                 std::chrono::milliseconds delay, std::chrono::milliseconds max_delay,
+                 ChangedCallback callback)
+    : m_suffix(std::move(suffix)),
+      m_delay(delay),
+      m_max_delay(max_delay),
+      m_callback(std::move(callback)),
+      m_input(io),
+      m_timer(io)
+{
+    m_fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (m_fd < 0)
+    {
+        std::cerr << "inotify_init1: " << std::strerror(errno) << std::endl;
+        return;
+    }
+
+    m_input.assign(m_fd);
+    read();
+}
+
+Watcher::~Watcher()
+{
+    // closes m_fd
+    asio::error_code ec;
+    m_input.close(ec);
+}
+
+void Watcher::watch(const std::string& dir)
+{
+    if (m_fd < 0)
+        return;
+
+    const int wd = inotify_add_watch(m_fd, dir.c_str(), WATCH_MASK);
+    if (wd < 0)
+    {
+        std::cerr << "cannot watch " << dir << ": " << std::strerror(errno) << std::endl;
+        return;
+    }
+
+    m_watches[wd] = dir;
+}
+
+void Watcher::read()
+{
+    m_input.async_read_some(asio::buffer(m_buffer),
+                            [this](const asio::error_code & ec, std::size_t length)
+    {
+        if (ec)
+        {
+            if (ec != asio::error::operation_aborted)
+                std::cerr << "inotify: " << ec.message() << std::endl;
+            return;
+        }
+
+        handle(m_buffer.data(), length);
+        read();
+    });
+}
+
+void Watcher::handle(const char* data, size_t size)
+{
+    bool relevant = false;
+
+    for (size_t pos = 0; pos + sizeof(struct inotify_event) <= size;)
+    {
+        const auto* event = reinterpret_cast<const struct inotify_event*>(data + pos);
+        pos += sizeof(struct inotify_event) + event->len;
+
+        if (event->mask & IN_Q_OVERFLOW)
+        {
+            relevant = true;
+            continue;
+        }
+
+        if (event->mask & IN_IGNORED)
+        {
+            m_watches.erase(event->wd);
+            continue;
+        }
+
+        // directories come and go with their manifests, a new one must be watched too
+        if (event->mask & (IN_ISDIR | IN_DELETE_SELF | IN_MOVE_SELF))
+        {
+            relevant = true;
+            continue;
+        }
+
+        if (event->len)
+        {
+            const auto len = std::strlen(event->name);
+            if (len >= m_suffix.size() &&
+                std::memcmp(event->name + len - m_suffix.size(), m_suffix.data(), m_suffix.size()) == 0)
+                relevant = true;
+        }
+    }
+
+    if (relevant)
+        changed();
+}
+
+void Watcher::changed()
+{
+    const auto now = std::chrono::steady_clock::now();
+    if (!m_pending)
+    {
+        m_pending = true;
+        m_first_change = now;
+    }
+
+    m_timer.expires_at(std::min(now + m_delay, m_first_change + m_max_delay));
+    m_timer.async_wait([this](const asio::error_code & ec)
+    {
+        if (ec)
+            return;
+
+        m_pending = false;
+        m_callback();
+    });
+}
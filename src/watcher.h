@@ -0,0 +1,69 @@
+/*
+ * Copyright (C) 2026 Microchip Technology Inc.  All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#ifndef EGT_LAUNCHER_WATCHER_H
+#define EGT_LAUNCHER_WATCHER_H
+
+#include <array>
+#include <chrono>
+#include <egt/asio.hpp>
+#include <functional>
+#include <string>
+#include <unordered_map>
+
+/**
+ * Watch directories for manifest changes with inotify.
+ *
+ * The inotify file descriptor is read from the io_context of the UI thread.
+ * Every relevant event restarts a short timer, so a burst of changes, such as
+ * a package install, results in a single invocation of the callback once
+ * the directories have been quiet for the whole delay. Directories which
+ * keep changing still get the callback max_delay after the first change.
+ */
+class Watcher
+{
+public:
+
+    using ChangedCallback = std::function<void()>;
+
+    Watcher(asio::io_context& io, std::string suffix,
+            std::chrono::milliseconds delay, std::chrono::milliseconds max_delay,
+            ChangedCallback callback);
+
+    Watcher(const Watcher&) = delete;
+    Watcher& operator=(const Watcher&) = delete;
+
+    ~Watcher();
+
+    /**
+     * Start watching a directory, if not watched already.
+     *
+     * This is not recursive, every subdirectory must be watched on its own.
+     */
+    void watch(const std::string& dir);
+
+private:
+
+    void read();
+
+    void handle(const char* data, size_t size);
+
+    void changed();
+
+    std::string m_suffix;
+    std::chrono::milliseconds m_delay;
+    std::chrono::milliseconds m_max_delay;
+    ChangedCallback m_callback;
+    int m_fd{-1};
+    asio::posix::stream_descriptor m_input;
+    asio::steady_timer m_timer;
+    /// A change is waiting for the callback, since m_first_change.
+    bool m_pending{false};
+    std::chrono::steady_clock::time_point m_first_change;
+    std::unordered_map<int, std::string> m_watches;
+    alignas(8) std::array<char, 4096> m_buffer{};
+};
+
+#endif
@@ -0,0 +1,273 @@
+/*
+ * Copyright (C) 2026 Microchip Technology Inc.  All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+/*
+ * Tests of the functions of the launcher which need neither a display nor
+ * a child process.
+ */
+
+#include "histogram.h"
+#include "keywatch.h"
+#include "process.h"
+#include "supervisor.h"
+#include <csignal>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <sys/wait.h>
+#include <vector>
+
+namespace
+{
+
+unsigned failures = 0;
+
+#define CHECK(condition) check((condition), #condition, __FILE__, __LINE__)
+
+void check(bool ok, const char* condition, const char* file, int line)
+{
+    if (ok)
+        return;
+
+    std::cerr << file << ":" << line << ": failed: " << condition << std::endl;
+    ++failures;
+}
+
+/// Wait status of a process which exited with code.
+int exit_status(int code)
+{
+    return (code & 0xff) << 8;
+}
+
+std::vector<std::string> split(const std::string& cmd)
+{
+    std::vector<std::string> argv;
+    if (!split_command(cmd, argv))
+        CHECK(argv.empty());
+    return argv;
+}
+
+bool splits(const std::string& cmd)
+{
+    std::vector<std::string> argv;
+    return split_command(cmd, argv);
+}
+
+void test_split_command()
+{
+    using Words = std::vector<std::string>;
+
+    CHECK(split("app") == Words({"app"}));
+    CHECK(split("  app\t-a  --b=c\n") == Words({"app", "-a", "--b=c"}));
+    CHECK(!splits(""));
+    CHECK(!splits(" \t\n"));
+
+    // quotes
+    CHECK(split("app 'a b' \"c d\"") == Words({"app", "a b", "c d"}));
+    CHECK(split("app 'a\"b' \"a'b\"") == Words({"app", "a\"b", "a'b"}));
+    CHECK(split("app a'b'\"c\"d") == Words({"app", "abcd"}));
+    CHECK(split("app '' \"\"") == Words({"app", "", ""}));
+    CHECK(split("app '$HOME|;'") == Words({"app", "$HOME|;"}));
+    CHECK(split("app \"a\\\"b\\\\c\\d\"") == Words({"app", "a\"b\\c\\d"}));
+    CHECK(split("app \"\\$HOME\"") == Words({"app", "$HOME"}));
+    CHECK(!splits("app 'a"));
+    CHECK(!splits("app \"a"));
+    CHECK(!splits("app \"$HOME\""));
+    CHECK(!splits("app \"`id`\""));
+
+    // backslashes and escaped newlines
+    CHECK(split("app a\\ b \\|") == Words({"app", "a b", "|"}));
+    CHECK(split("app \\\n-a") == Words({"app", "-a"}));
+    CHECK(split("app a\\\nb") == Words({"app", "ab"}));
+    CHECK(split("app \"a\\\nb\"") == Words({"app", "ab"}));
+    CHECK(!splits("app \\"));
+
+    // =, ~ and # only matter at the start of a word
+    CHECK(!splits("VAR=1 app"));
+    CHECK(split("app --opt=1 =a") == Words({"app", "--opt=1", "=a"}));
+    CHECK(!splits("~/bin/app"));
+    CHECK(!splits("app ~/file"));
+    CHECK(split("app a~b") == Words({"app", "a~b"}));
+    CHECK(!splits("app # comment"));
+    CHECK(!splits("app #comment"));
+    CHECK(split("app a#b") == Words({"app", "a#b"}));
+
+    // anything else needs a shell
+    for (const char* cmd :
+         {
+             "app | cat", "app & ", "app; app", "app < in", "app > out", "(app)",
+             "app $HOME", "app `id`", "app *.png", "app ?", "app [a]", "app {a,b}",
+             "! app",
+         })
+    {
+        CHECK(!splits(cmd));
+    }
+}
+
+void test_parse_key_codes()
+{
+    KeyCodes codes;
+
+    CHECK(parse_key_codes("", codes) && codes.empty());
+    CHECK(parse_key_codes("1", codes) && codes == KeyCodes({1}));
+    CHECK(parse_key_codes("1,28 0x74\t,\n59", codes) && codes == KeyCodes({1, 28, 116, 59}));
+    CHECK(parse_key_codes(" , 1 ,", codes) && codes == KeyCodes({1}));
+    CHECK(parse_key_codes(std::to_string(KEY_MAX), codes) && codes == KeyCodes({KEY_MAX}));
+
+    for (const char* list : {"0", "a", "1,a", "1;2", "-1", "1.5"})
+    {
+        codes = {1};
+        CHECK(!parse_key_codes(list, codes) && codes.empty());
+    }
+    CHECK(!parse_key_codes(std::to_string(KEY_MAX + 1), codes));
+
+    CHECK(parse_key_codes(format_key_codes({1, 28, 116}), codes) && codes == KeyCodes({1, 28, 116}));
+}
+
+void test_supervisor()
+{
+    using Action = Supervisor::Action;
+    using std::chrono::milliseconds;
+
+    // an exit of 0 or with an exit key returns home, whatever the policy
+    {
+        Supervisor supervisor;
+        supervisor.started("app", false);
+        CHECK(supervisor.exited("app", exit_status(0), false, RestartPolicy::restart).action ==
+              Action::home);
+        supervisor.started("app", false);
+        CHECK(supervisor.exited("app", SIGTERM, true, RestartPolicy::restart).action ==
+              Action::home);
+        CHECK(supervisor.records().at("app").failures == 0);
+    }
+
+    // home does not restart failures
+    {
+        Supervisor supervisor;
+        supervisor.started("app", false);
+        CHECK(supervisor.exited("app", exit_status(1), false, RestartPolicy::home).action ==
+              Action::home);
+        CHECK(supervisor.records().at("app").failures == 1);
+    }
+
+    // restart right away, until more than CRASH_LOOP_FAILURES in the window
+    {
+        Supervisor supervisor;
+        supervisor.started("app", false);
+        for (unsigned i = 0; i < Supervisor::CRASH_LOOP_FAILURES; ++i)
+        {
+            const auto decision = supervisor.exited("app", SIGSEGV, false, RestartPolicy::restart);
+            CHECK(decision.action == Action::restart);
+            CHECK(decision.delay == milliseconds(0));
+            supervisor.started("app", true);
+        }
+        CHECK(supervisor.exited("app", SIGSEGV, false, RestartPolicy::restart).action ==
+              Action::give_up);
+
+        const auto& record = supervisor.records().at("app");
+        CHECK(record.failures == Supervisor::CRASH_LOOP_FAILURES + 1);
+        CHECK(record.restarts == Supervisor::CRASH_LOOP_FAILURES);
+        CHECK(record.given_up == 1);
+
+        // a launch from the launcher starts over
+        supervisor.started("app", false);
+        CHECK(supervisor.exited("app", SIGSEGV, false, RestartPolicy::restart).action ==
+              Action::restart);
+    }
+
+    // the backoff doubles on failures in a row
+    {
+        Supervisor supervisor;
+        supervisor.started("app", false);
+        auto expected = Supervisor::BACKOFF_MIN;
+        for (unsigned i = 0; i < Supervisor::CRASH_LOOP_FAILURES; ++i)
+        {
+            const auto decision = supervisor.exited("app", exit_status(1), false,
+                                                    RestartPolicy::backoff);
+            CHECK(decision.action == Action::restart);
+            CHECK(decision.delay == expected);
+            expected *= 2;
+            supervisor.started("app", true);
+        }
+        CHECK(supervisor.exited("app", exit_status(1), false, RestartPolicy::backoff).action ==
+              Action::give_up);
+
+        // a launch from the launcher resets the backoff
+        supervisor.started("app", false);
+        const auto decision = supervisor.exited("app", exit_status(1), false, RestartPolicy::backoff);
+        CHECK(decision.action == Action::restart);
+        CHECK(decision.delay == Supervisor::BACKOFF_MIN);
+    }
+
+    // applications are supervised apart
+    {
+        Supervisor supervisor;
+        supervisor.started("a", false);
+        supervisor.started("b", false);
+        supervisor.exited("a", exit_status(1), false, RestartPolicy::backoff);
+        CHECK(supervisor.exited("b", exit_status(1), false, RestartPolicy::backoff).delay ==
+              Supervisor::BACKOFF_MIN);
+    }
+
+    CHECK(Supervisor::status_name(exit_status(3)) == "exit 3");
+    CHECK(Supervisor::status_name(SIGSEGV) == "signal " + std::to_string(SIGSEGV));
+}
+
+void test_histogram()
+{
+    Histogram histogram;
+    CHECK(histogram.count_at_most(0) == 0);
+    CHECK(histogram.count_at_most(1000) == 0);
+
+    // values below 64 have a bucket each
+    for (uint64_t value = 0; value < 64; ++value)
+        histogram.record(value);
+    CHECK(histogram.count_at_most(0) == 1);
+    CHECK(histogram.count_at_most(31) == 32);
+    CHECK(histogram.count_at_most(63) == 64);
+    CHECK(histogram.count_at_most(1000) == 64);
+
+    // above, within the 3% of a bucket
+    histogram.reset();
+    for (int i = 0; i < 10; ++i)
+    {
+        histogram.record(1000);
+        histogram.record(100000);
+    }
+    CHECK(histogram.count_at_most(900) == 0);
+    CHECK(histogram.count_at_most(1040) == 10);
+    CHECK(histogram.count_at_most(90000) == 10);
+    CHECK(histogram.count_at_most(100000) == 20);
+    CHECK(histogram.count_at_most(UINT64_MAX) == 20);
+
+    // larger values are clamped, but counted
+    histogram.record(UINT64_MAX);
+    CHECK(histogram.count() == 21);
+    CHECK(histogram.count_at_most(103000) == 20);
+    CHECK(histogram.count_at_most(UINT64_MAX) == 21);
+}
+
+}
+
+int main()
+{
+    test_split_command();
+    test_parse_key_codes();
+    test_supervisor();
+    test_histogram();
+
+    if (failures)
+    {
+        std::cerr << failures << " checks failed" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    std::cout << "all checks passed" << std::endl;
+    return EXIT_SUCCESS;
+}